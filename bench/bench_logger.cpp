@@ -0,0 +1,40 @@
+#include "../include/trttl.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+using namespace trttl;
+
+const char* volatile message = "Benchmark log message.";  // volatile - keeps call sites alive
+
+// Runs `f` `iters` times, returns mean ns per call
+template<typename F>
+double measure(F&& f, int iters) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i)
+        f();
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / iters;
+}
+
+void report(const char* name, double ns) {
+    std::cout << std::left << std::setw(40) << name << std::fixed << std::setprecision(3) << ns << " ns/call\n";
+}
+
+int main() {
+    constexpr int disabled_iters = 100000000;
+    constexpr int enabled_iters = 200000;
+
+    report("loop overhead (baseline)", measure([&] { const char* m = message; (void)m; }, disabled_iters));
+
+    Logger<NoLog, NoLog, NoLog, NoLog, NoLog> disabled;
+    report("print<kVERBOSE> -> NoLog", measure([&] { disabled.print<trt_types::Severity::kVERBOSE>(message); }, disabled_iters));
+    report("log(kVERBOSE) -> NoLog", measure([&] { disabled.log(trt_types::Severity::kVERBOSE, message); }, disabled_iters));
+
+    Logger<NoLog, NoLog, NoLog, FileLog, NoLog> enabled;
+    report("print<kINFO> -> FileLog", measure([&] { enabled.print<trt_types::Severity::kINFO>(message); }, enabled_iters));
+    report("log(kINFO) -> FileLog", measure([&] { enabled.log(trt_types::Severity::kINFO, message); }, enabled_iters));
+    report("log(kVERBOSE) -> NoLog (mixed logger)", measure([&] { enabled.log(trt_types::Severity::kVERBOSE, message); }, disabled_iters));
+
+    return 0;
+}
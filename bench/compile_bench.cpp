@@ -0,0 +1,47 @@
+// Compile-time benchmark - instantiates generated models of TRTTL_BENCH_DEPTH layers.
+// Built as object libraries by CMake (TRTTL_COMPILE_BENCH=ON); with Clang each object gets
+// a -ftime-trace JSON next to it (open in chrome://tracing or https://ui.perfetto.dev).
+#include "../include/trttl.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifndef TRTTL_BENCH_DEPTH
+#define TRTTL_BENCH_DEPTH 100
+#endif
+
+using namespace trttl;
+
+namespace {
+
+constexpr trt_types::Dims in{2, {1, 64}};
+
+// Linear, ReLU, Linear, ReLU... - activations keep linears apart, so nothing is folded away
+template<std::size_t... Is>
+auto flatImpl(std::index_sequence<Is...>)
+    -> AutoSequential<8, in, trt_types::DataType::kFLOAT, std::conditional_t<Is % 2 == 0, layers::Linear<64>, layers::Relu>...>;
+
+using Flat = decltype(flatImpl(std::make_index_sequence<TRTTL_BENCH_DEPTH>{}));
+
+// Same depth as blocks of 10 nested Sequentials - exercises flattening
+using Block = layers::Chain<layers::Linear<64>, layers::Relu, layers::Linear<64>, layers::Relu, layers::Linear<64>,
+                            layers::Relu, layers::Linear<64>, layers::Relu, layers::Linear<64>, layers::Relu>;
+
+template<std::size_t... Is>
+auto nestedImpl(std::index_sequence<Is...>)
+    -> AutoSequential<8, in, trt_types::DataType::kFLOAT, std::conditional_t<Is == 0, Block, Block>...>;
+
+using Nested = decltype(nestedImpl(std::make_index_sequence<TRTTL_BENCH_DEPTH / 10>{}));
+
+static_assert(std::tuple_size_v<Flat::Lowered> == (TRTTL_BENCH_DEPTH + 1) / 2);
+static_assert(std::tuple_size_v<Nested::Lowered> == TRTTL_BENCH_DEPTH / 10 * 5);
+static_assert(Flat::cost().params > 0 && Nested::fingerprint() != Flat::fingerprint());
+
+} // namespace
+
+// Everything a real user would instantiate - graph lowering, CPU path, binding, hashing
+trt_types::Tensor* benchFlat(Flat& m, trt_types::Network* n, trt_types::Tensor* x) { return m.addToNetwork(n, x); }
+trt_types::Tensor* benchNested(Nested& m, trt_types::Network* n, trt_types::Tensor* x) { return m.addToNetwork(n, x); }
+void benchForward(Flat& m, const float* x, float* y, float* scratch) { m.forward(x, y, scratch); }
+void benchBind(Nested& m, const Checkpoint& ckpt) { m.bind(ckpt, "model"); }
+uint64_t benchHash(const Flat& f, const Nested& n) { return f.weightsHash() ^ n.weightsHash(); }
@@ -0,0 +1,288 @@
+#include "../include/trttl.h"
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <barrier>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+
+using namespace trttl;
+
+#ifndef TRTTL_GIT_REV
+#define TRTTL_GIT_REV "unknown"
+#endif
+
+using clk = std::chrono::steady_clock;
+
+/*!
+* One measured value - `name` stays stable across commits so results can be diffed.
+*/
+struct Result {
+    std::string name;
+    std::string unit;
+    double value;
+};
+
+std::vector<Result> results;
+
+void report(std::string name, std::string unit, double value) {
+    std::cerr << std::left << std::setw(56) << name << std::fixed << std::setprecision(3) << value << ' ' << unit << '\n';
+    results.push_back({std::move(name), std::move(unit), value});
+}
+
+double percentile(std::vector<double>& v, double p) {
+    if (v.empty())
+        return 0.0;
+    const auto k = static_cast<std::size_t>(p * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// Runs `f` `iters` times, returns mean ns per call
+template<typename F>
+double measure(F&& f, std::size_t iters) {
+    const auto start = clk::now();
+    for (std::size_t i = 0; i < iters; ++i)
+        f();
+    return std::chrono::duration<double, std::nano>(clk::now() - start).count() / static_cast<double>(iters);
+}
+
+const char* volatile message = "Benchmark log message.";  // volatile - keeps call sites alive
+
+// Logger throughput & latency under `threads` concurrent producers
+template<typename L>
+void benchLogger(const std::string& sink, L& logger, int threads, std::size_t iters) {
+    std::vector<std::vector<double>> lat(threads, std::vector<double>(iters));
+    std::barrier start(threads + 1);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&, t] {
+            start.arrive_and_wait();
+            for (std::size_t i = 0; i < iters; ++i) {
+                const auto t0 = clk::now();
+                logger.template print<trt_types::Severity::kINFO>(message);
+                lat[t][i] = std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+            }
+        });
+    start.arrive_and_wait();
+    const auto t0 = clk::now();
+    for (auto& th : pool)
+        th.join();
+    if constexpr (requires { logger.flush(); })
+        logger.flush();                                     // async: count messages written, not just queued
+    const double secs = std::chrono::duration<double>(clk::now() - t0).count();
+
+    std::vector<double> all;
+    for (auto& v : lat)
+        all.insert(all.end(), v.begin(), v.end());
+    const std::string prefix = "logger." + sink + ".t" + std::to_string(threads);
+    report(prefix + ".throughput", "msg/s", static_cast<double>(all.size()) / secs);
+    report(prefix + ".p50", "ns", percentile(all, 0.50));
+    report(prefix + ".p99", "ns", percentile(all, 0.99));
+}
+
+constexpr LogFileConfig bench_log{.path = "trt_bench.log", .max_bytes = std::size_t{16} << 20, .keep = 3};
+
+void benchLoggers() {
+    constexpr std::size_t iters = 20000;
+    report("logger.disabled.print", "ns", measure([] {
+        static Logger<NoLog, NoLog, NoLog, NoLog, NoLog> disabled;
+        disabled.print<trt_types::Severity::kINFO>(message);
+    }, 10000000));
+    {
+        Logger<NoLog, NoLog, NoLog, NoLog, FileLog> sampled;
+        sampled.limits().limit(trt_types::Severity::kVERBOSE, {.sample_every = 1000});
+        report("logger.sampled_1000.log", "ns", measure([&] { sampled.log(trt_types::Severity::kVERBOSE, message); }, 2000000));
+    }
+    for (int threads : {1, 2, 4, 8}) {
+        {
+            Logger<NoLog, NoLog, NoLog, FileLog, NoLog> file;
+            benchLogger("file", file, threads, iters);
+        }
+        {
+            AsyncLogger<NoLog, NoLog, NoLog, FileLog, NoLog, trt_types::Severity::kERROR, OverflowPolicy::kBLOCK, 4096> async;
+            benchLogger("async_file", async, threads, iters);
+        }
+        {
+            Logger<NoLog, NoLog, NoLog, RotatingFileLog<bench_log>, NoLog> rotating;
+            benchLogger("rotating", rotating, threads, iters);
+        }
+        {
+            AsyncLogger<NoLog, NoLog, NoLog, RotatingFileLog<bench_log>, NoLog, trt_types::Severity::kERROR, OverflowPolicy::kBLOCK, 4096> async;
+            benchLogger("async_rotating", async, threads, iters);
+        }
+        {
+            Logger<NoLog, NoLog, NoLog, BinaryLog, NoLog> binary;
+            benchLogger("binary", binary, threads, iters);
+        }
+        {
+            AsyncLogger<NoLog, NoLog, NoLog, BinaryLog, NoLog, trt_types::Severity::kERROR, OverflowPolicy::kBLOCK, 4096> async;
+            benchLogger("async_binary", async, threads, iters);
+        }
+    }
+    std::filesystem::remove("trt.log");
+    std::filesystem::remove("trt.blog");
+    for (const char* p : {"trt_bench.log", "trt_bench.log.1", "trt_bench.log.2", "trt_bench.log.3"})
+        std::filesystem::remove(p);
+}
+
+template<int32_t W>
+using Lin = LinearLayer<1, trt_types::Dims{2, {1, W}}, trt_types::Dims{2, {1, W}}, trt_types::DataType::kFLOAT>;
+template<int32_t W>
+using Relu = ActivationLayer<1, trt_types::Dims{2, {1, W}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+
+template<int32_t W, std::size_t... Is>
+auto deepImpl(std::index_sequence<Is...>)
+    -> Sequential<1, trt_types::Dims{2, {1, W}}, trt_types::Dims{2, {1, W}}, trt_types::DataType::kFLOAT,
+                  std::conditional_t<Is % 2 == 0, Lin<W>, Relu<W>>...>;
+
+/*!
+* `D` x (Linear W->W, ReLU) - activations keep linears from being folded together.
+*/
+template<int32_t W, std::size_t D>
+using Deep = decltype(deepImpl<W>(std::make_index_sequence<2 * D>{}));
+
+// Network definition construction (no engine build)
+template<int32_t W, std::size_t D>
+void benchGraph(nvinfer1::IBuilder* builder, std::size_t iters) {
+    Deep<W, D> model;
+    std::vector<double> times;
+    for (std::size_t i = 0; i <= iters; ++i) {
+        const auto t0 = clk::now();
+        std::unique_ptr<trt_types::Network> network(builder->createNetworkV2(
+            1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH)));
+        auto* input = network->addInput("input", trt_types::DataType::kFLOAT, trt_types::Dims{2, {1, W}});
+        network->markOutput(*model.addToNetwork(network.get(), input));
+        const double ns = std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+        if (i == 0)
+            report("graph.w" + std::to_string(W) + ".d" + std::to_string(D) + ".first", "us", ns / 1e3);  // includes lowering
+        else
+            times.push_back(ns);
+    }
+    report("graph.w" + std::to_string(W) + ".d" + std::to_string(D) + ".p50", "us", percentile(times, 0.5) / 1e3);
+}
+
+void benchGraphs() {
+    DefaultLogger logger;
+    std::unique_ptr<trt_types::Builder> builder(nvinfer1::createInferBuilder(logger));
+    if (!builder) {
+        std::cerr << "graph: no CUDA device, skipped\n";
+        return;
+    }
+    benchGraph<64, 1>(builder.get(), 200);
+    benchGraph<64, 4>(builder.get(), 200);
+    benchGraph<64, 16>(builder.get(), 100);
+    benchGraph<1024, 1>(builder.get(), 100);
+    benchGraph<1024, 4>(builder.get(), 50);
+    benchGraph<1024, 16>(builder.get(), 20);
+}
+
+// Writes safetensors checkpoint matching `Deep<W, D>`
+void writeCheckpoint(const std::string& path, int32_t W, std::size_t D) {
+    const std::size_t wbytes = static_cast<std::size_t>(W) * W * sizeof(float), bbytes = W * sizeof(float);
+    std::string header = "{";
+    std::size_t offset = 0;
+    for (std::size_t d = 0; d < D; ++d) {
+        const std::string idx = std::to_string(2 * d);
+        header += (d ? "," : "") + ("\"" + idx + ".weight\":{\"dtype\":\"F32\",\"shape\":[") + std::to_string(W) + "," +
+                  std::to_string(W) + "],\"data_offsets\":[" + std::to_string(offset) + "," + std::to_string(offset + wbytes) + "]}";
+        offset += wbytes;
+        header += ",\"" + idx + ".bias\":{\"dtype\":\"F32\",\"shape\":[" + std::to_string(W) + "],\"data_offsets\":[" +
+                  std::to_string(offset) + "," + std::to_string(offset + bbytes) + "]}";
+        offset += bbytes;
+    }
+    header += "}";
+    while (header.size() % 8)
+        header += ' ';
+
+    std::ofstream f(path, std::ios::binary);
+    const uint64_t len = header.size();
+    f.write(reinterpret_cast<const char*>(&len), 8);
+    f << header;
+    const std::vector<float> payload(offset / sizeof(float), 0.01f);
+    f.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(offset));
+}
+
+// Checkpoint mapping, zero-copy bind and weights hashing
+template<int32_t W, std::size_t D>
+void benchWeights(std::size_t iters) {
+    const std::string path = "trttl_bench.safetensors";
+    writeCheckpoint(path, W, D);
+    const double mb = static_cast<double>(std::filesystem::file_size(path)) / (1 << 20);
+    const std::string prefix = "weights.w" + std::to_string(W) + ".d" + std::to_string(D);
+
+    report(prefix + ".load", "us", measure([&] {
+        Checkpoint ckpt;
+        ckpt.addSafetensors(path);
+    }, iters) / 1e3);
+
+    Checkpoint ckpt;
+    ckpt.addSafetensors(path);
+    Deep<W, D> model;
+    report(prefix + ".bind", "us", measure([&] { model.bind(ckpt, ""); }, iters) / 1e3);
+
+    volatile uint64_t sink = 0;
+    const double ns = measure([&] { sink = sink + model.weightsHash(); }, iters);
+    report(prefix + ".hash", "MB/s", mb / (ns / 1e9));
+    std::filesystem::remove(path);
+}
+
+void benchShapes() {
+    volatile int32_t rank = 4;
+    trt_types::Dims a{rank, {8, 3, 224, 224}}, b = a;
+    volatile int64_t sink = 0;
+    report("shape.dimVolume", "ns", measure([&] { sink = sink + dimVolume(a); }, 50000000));
+    report("shape.equal", "ns", measure([&] { sink = sink + (a == b); }, 50000000));
+    report("shape.strides", "ns", measure([&] { sink = sink + dimStrides(a).d[0]; }, 50000000));
+}
+
+// u8 HWC image to normalized CHW sample, per instruction set
+template<typename V>
+void benchPreprocess(std::size_t iters) {
+    using Image = IdentityLayer<1, trt_types::Dims{3, {3, 224, 224}}, trt_types::DataType::kFLOAT>;
+    using P = Preprocessor<Image, V>;
+    const P pre({123.675f, 116.28f, 103.53f}, {58.395f, 57.12f, 57.375f});
+    const std::vector<uint8_t> image(P::image_size, 128);
+    std::vector<float> sample(P::sample_size);
+    const double ns = measure([&] { pre.run(typename P::Image(image.data(), P::image_size), typename P::Sample(sample.data(), P::sample_size)); }, iters);
+    report(std::string("preprocess.224x224x3.") + V::name, "us", ns / 1e3);
+}
+
+void writeJson(std::ostream& out) {
+    out << "{\n  \"rev\": \"" << TRTTL_GIT_REV << "\",\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i)
+        out << "    {\"name\": \"" << results[i].name << "\", \"unit\": \"" << results[i].unit << "\", \"value\": "
+            << std::setprecision(6) << results[i].value << (i + 1 < results.size() ? "},\n" : "}\n");
+    out << "  ]\n}\n";
+}
+
+/*!
+* Usage: trttl_bench [out.json] - JSON to file (or stdout), readable table to stderr.
+*/
+int main(int argc, char** argv) {
+    try {
+        benchLoggers();
+        benchGraphs();
+        benchWeights<256, 4>(200);
+        benchWeights<1024, 16>(10);
+        benchShapes();
+        benchPreprocess<simd_utils::Scalar>(2000);
+        if constexpr (simd_utils::Native::width > 1)
+            benchPreprocess<simd_utils::Native>(2000);
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (argc > 1) {
+        std::ofstream out(argv[1]);
+        writeJson(out);
+    } else {
+        writeJson(std::cout);
+    }
+    return 0;
+}
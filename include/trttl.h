@@ -3,9 +3,32 @@
 
 #include "trttl/utils.hpp"
 #include "trttl/logger.hpp"
+#include "trttl/async_logger.hpp"
+#include "trttl/binary_log.hpp"
+#include "trttl/log_limiter.hpp"
+#include "trttl/rotating_log.hpp"
 #include "trttl/modules.hpp"
+#include "trttl/weights.hpp"
+#include "trttl/plan_cache.hpp"
+#include "trttl/timing_cache.hpp"
+#include "trttl/build_policy.hpp"
+#include "trttl/profiler.hpp"
+#include "trttl/tracing.hpp"
+#include "trttl/build_pool.hpp"
+#include "trttl/buffers.hpp"
+#include "trttl/cpu_executor.hpp"
+#include "trttl/preprocess.hpp"
+#include "trttl/batcher.hpp"
+#include "trttl/calibrator.hpp"
 
 #include "trttl/util/trt_types.hpp"
 #include "trttl/util/cexpr_utils.hpp"
+#include "trttl/util/parse_utils.hpp"
+#include "trttl/util/file_utils.hpp"
+#include "trttl/util/mpsc_queue.hpp"
+#include "trttl/util/hash_utils.hpp"
+#include "trttl/util/simd_utils.hpp"
+#include "trttl/util/cpu_kernels.hpp"
+#include "trttl/util/quant_utils.hpp"
 
 #endif // TRTTL_H
\ No newline at end of file
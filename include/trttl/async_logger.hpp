@@ -0,0 +1,323 @@
+#ifndef ASYNC_LOGGER_HPP
+#define ASYNC_LOGGER_HPP
+
+#include "log_limiter.hpp"
+#include "logger.hpp"
+#include "util/mpsc_queue.hpp"
+#include "util/cexpr_utils.hpp"
+#include "util/trt_types.hpp"
+#include <NvInfer.h>
+#include <source_location>
+#include <type_traits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <tuple>
+#include <mutex>
+
+namespace trttl {
+
+/*!
+* What `AsyncLogger` does when its queue is full.
+*/
+enum class OverflowPolicy {
+    kBLOCK,         /*!< Producer waits for free slot.*/
+    kDROP_NEWEST,   /*!< Incoming record is discarded.*/
+    kDROP_OLDEST    /*!< Oldest queued record is evicted to make room.*/
+};
+
+/*!
+* Fixed-size log record passed from producers to the writer thread.
+* Messages longer than `max_msg` are truncated.
+*/
+struct LogRecord {
+    static constexpr std::size_t max_msg = 440;
+
+    std::time_t time;
+    uint64_t ticks;                 /*!< `LogClock` time, only taken when a `RecordSink` is attached.*/
+    std::source_location location;
+    uint32_t severity;
+    char msg[max_msg + 1];
+};
+
+/*!
+* Asynchronous logger - same template interface as `Logger`.
+* Producers copy a `LogRecord` into a bounded lock-free queue,
+* single background thread formats it and writes to `LogStream`s.
+* Streams are flushed once per drained batch instead of per line.
+* Destructor writes out everything that was queued.
+*
+* @tparam policy - behaviour on full queue
+* @tparam capacity - queue size (power of two)
+*/
+template <DerivedFromLogStream LogStreamINTERNAL_ERROR = NoLog,
+          DerivedFromLogStream LogStreamERROR = NoLog,
+          DerivedFromLogStream LogStreamWARNING = NoLog,
+          DerivedFromLogStream LogStreamINFO = NoLog,
+          DerivedFromLogStream LogStreamVERBOSE = NoLog,
+          trt_types::Severity throwSeverity = trt_types::Severity::kERROR,
+          OverflowPolicy policy = OverflowPolicy::kBLOCK,
+          std::size_t capacity = 1024>
+class AsyncLogger : public nvinfer1::ILogger {
+private:
+    using Streams = std::tuple<LogStreamINTERNAL_ERROR,
+                               LogStreamERROR,
+                               LogStreamWARNING,
+                               LogStreamINFO,
+                               LogStreamVERBOSE>;
+
+    static std::mutex mtx;                                    /*!< Serializes writers of same logger type.*/
+    static constexpr bool active[5] = {                       /*!< Levels that write or throw.*/
+        log_enabled<LogStreamINTERNAL_ERROR> || throwSeverity == trt_types::Severity::kINTERNAL_ERROR,
+        log_enabled<LogStreamERROR> || throwSeverity == trt_types::Severity::kERROR,
+        log_enabled<LogStreamWARNING> || throwSeverity == trt_types::Severity::kWARNING,
+        log_enabled<LogStreamINFO> || throwSeverity == trt_types::Severity::kINFO,
+        log_enabled<LogStreamVERBOSE> || throwSeverity == trt_types::Severity::kVERBOSE
+    };
+
+    static constexpr bool raw = RecordSink<LogStreamINTERNAL_ERROR> || RecordSink<LogStreamERROR> ||
+                                RecordSink<LogStreamWARNING> || RecordSink<LogStreamINFO> || RecordSink<LogStreamVERBOSE>;
+
+    Streams log_streams;                                      /*!< `LogStream` objects container - writer thread only.*/
+    conc_utils::MPSCQueue<LogRecord, capacity> queue;         /*!< Pending records.*/
+    LogLimiter limiter;                                       /*!< Sampling & rate limits, checked before enqueueing.*/
+
+    alignas(conc_utils::cache_line) std::atomic<uint64_t> pushed{0};    /*!< Records accepted into queue.*/
+    alignas(conc_utils::cache_line) std::atomic<uint64_t> done{0};      /*!< Records written or evicted.*/
+    std::atomic<uint64_t> dropped_count{0};                              /*!< Records lost to overflow.*/
+    std::atomic<uint32_t> wake{0};                                       /*!< Writer wake-up futex.*/
+    std::atomic<bool> idle{false};                                       /*!< Writer is (about to be) asleep.*/
+    std::atomic<bool> stop{false};
+
+    std::thread writer;
+
+    void notify() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (idle.load(std::memory_order_relaxed) && idle.exchange(false)) {
+            wake.fetch_add(1);
+            wake.notify_one();
+        }
+    }
+
+    bool enqueue(const LogRecord& rec) noexcept {
+        if constexpr (policy == OverflowPolicy::kBLOCK) {
+            while (!queue.try_push(rec)) {
+                notify();
+                std::this_thread::yield();
+            }
+        } else if constexpr (policy == OverflowPolicy::kDROP_NEWEST) {
+            if (!queue.try_push(rec)) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } else {
+            LogRecord old;
+            while (!queue.try_push(rec)) {
+                if (queue.try_pop(old)) {
+                    dropped_count.fetch_add(1, std::memory_order_relaxed);
+                    done.fetch_add(1);
+                    done.notify_all();
+                }
+            }
+        }
+        pushed.fetch_add(1);
+        notify();
+        return true;
+    }
+
+    template<std::size_t i>
+    void write_one(const LogRecord& rec) {
+        if constexpr (RecordSink<std::tuple_element_t<i, Streams>>) {
+            std::get<i>(log_streams).record(rec.severity, rec.ticks, rec.location, rec.msg);
+        } else if constexpr (log_enabled<std::tuple_element_t<i, Streams>>) {
+            auto&& stream = std::get<i>(log_streams).get();
+            LogFormat::write(stream, i, rec.time, rec.location, rec.msg);
+            stream << '\n';
+            if constexpr (CommitSink<std::tuple_element_t<i, Streams>>)
+                std::get<i>(log_streams).commit(static_cast<uint32_t>(i));
+        }
+    }
+
+    template<std::size_t... Is>
+    void write_record(const LogRecord& rec, std::index_sequence<Is...>) {
+        ((rec.severity == Is ? write_one<Is>(rec) : void()), ...);
+    }
+
+    template<std::size_t i>
+    void flush_one() {
+        if constexpr (RecordSink<std::tuple_element_t<i, Streams>>)
+            std::get<i>(log_streams).flush();
+        else if constexpr (!CommitSink<std::tuple_element_t<i, Streams>>)    // flushes on its own policy
+            std::get<i>(log_streams).get().flush();
+    }
+
+    template<std::size_t... Is>
+    void flush_streams(std::index_sequence<Is...>) {
+        (flush_one<Is>(), ...);
+    }
+
+    /*!
+    * Writer loop - drains queue in batches, sleeps on `wake` when empty.
+    */
+    void run() {
+        LogRecord rec;
+        for (;;) {
+            uint64_t n = 0;
+            if (queue.try_pop(rec)) {
+                std::lock_guard<std::mutex> lock(mtx);
+                do {
+                    write_record(rec, std::make_index_sequence<5>{});
+                    ++n;
+                } while (n < capacity && queue.try_pop(rec));
+                flush_streams(std::make_index_sequence<5>{});
+            }
+            if (n > 0) {
+                done.fetch_add(n);
+                done.notify_all();
+                continue;
+            }
+            if (stop.load())
+                return;
+
+            idle.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const uint32_t w = wake.load();
+            if (!queue.empty() || stop.load()) {
+                idle.store(false);
+                continue;
+            }
+            wake.wait(w);
+        }
+    }
+
+    template<trt_types::Severity severity>
+    void print_impl(const char* msg, const std::source_location& location) {
+        constexpr auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
+        if constexpr (log_enabled<std::tuple_element_t<i, Streams>>) {
+            LogRecord rec;
+            rec.time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            if constexpr (raw)
+                rec.ticks = LogClock::now();
+            rec.location = location;
+            rec.severity = static_cast<uint32_t>(i);
+            const std::size_t len = strnlen(msg, LogRecord::max_msg);
+            std::memcpy(rec.msg, msg, len);
+            rec.msg[len] = '\0';
+            enqueue(rec);
+        }
+    }
+
+    template<std::size_t... Is>
+    void print_at(uint32_t i, const char* msg, const std::source_location& location, std::index_sequence<Is...>) {
+        ((i == Is ? print_impl<static_cast<trt_types::Severity>(Is)>(msg, location) : void()), ...);
+    }
+
+public:
+    AsyncLogger() : writer([this] { run(); }) {}
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    ~AsyncLogger() {
+        const auto location = std::source_location::current();
+        limiter.drain([&](uint32_t i, const char* msg) { print_at(i, msg, location, std::make_index_sequence<5>{}); });
+        stop.store(true);
+        wake.fetch_add(1);
+        wake.notify_one();
+        writer.join();
+    }
+
+    /*!
+    * Log function interface handles throwing.
+    * Throwing severity is flushed before exception leaves and bypasses `limits()`.
+    */
+    template<trt_types::Severity severity>
+    void print(const char* msg, const std::source_location location =
+               std::source_location::current()
+    ) {
+        constexpr auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
+        if constexpr (severity != throwSeverity && log_enabled<std::tuple_element_t<i, Streams>>) {
+            if (!limiter.admit(static_cast<uint32_t>(i), msg, [&](const char* summary) { print_impl<severity>(summary, location); }))
+                return;
+        }
+        print_impl<severity>(msg, location);
+        if constexpr (severity == throwSeverity) {
+            flush();
+            throw std::runtime_error("Runtime error occurred.");
+        }
+    }
+
+    /*!
+    * Just for TRT C++ API comaptibility.
+    */
+    void log(trt_types::Severity severity, const char* msg) noexcept override {
+        const auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
+        if (i < 0 || i >= 5 || !active[i])
+            return;
+        switch (severity) {
+            case trt_types::Severity::kINTERNAL_ERROR:
+                print<trt_types::Severity::kINTERNAL_ERROR>(msg);
+                break;
+            case trt_types::Severity::kERROR:
+                print<trt_types::Severity::kERROR>(msg);
+                break;
+            case trt_types::Severity::kWARNING:
+                print<trt_types::Severity::kWARNING>(msg);
+                break;
+            case trt_types::Severity::kINFO:
+                print<trt_types::Severity::kINFO>(msg);
+                break;
+            case trt_types::Severity::kVERBOSE:
+                print<trt_types::Severity::kVERBOSE>(msg);
+                break;
+            default:
+                break;
+        }
+    }
+
+    /*!
+    * Blocks until every record accepted so far has been written (or evicted).
+    */
+    void flush() {
+        const uint64_t target = pushed.load();
+        notify();
+        for (uint64_t d = done.load(); d < target; d = done.load())
+            done.wait(d);
+    }
+
+    /*!
+    * Sampling & rate limiting rules, see `LogLimiter`.
+    */
+    LogLimiter& limits() noexcept {
+        return limiter;
+    }
+
+    /*!
+    * Number of records lost due to overflow policy.
+    */
+    uint64_t dropped() const noexcept {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+};
+
+template <DerivedFromLogStream LogStreamINTERNAL_ERROR,
+    DerivedFromLogStream LogStreamERROR,
+    DerivedFromLogStream LogStreamWARNING,
+    DerivedFromLogStream LogStreamINFO,
+    DerivedFromLogStream LogStreamVERBOSE,
+    trt_types::Severity throwSeverity,
+    OverflowPolicy policy,
+    std::size_t capacity>
+std::mutex AsyncLogger<LogStreamINTERNAL_ERROR, LogStreamERROR, LogStreamWARNING, LogStreamINFO, LogStreamVERBOSE, throwSeverity, policy, capacity>::mtx;
+
+/*!
+* Convinience naming for async logger with default LogStreams setup.
+*/
+using DefaultAsyncLogger = AsyncLogger<CerrLog, CerrLog, CoutLog, CoutLog, RotatingFileLog<>>;
+
+} // trttl namespace
+#endif // ASYNC_LOGGER_HPP
@@ -0,0 +1,216 @@
+#ifndef BATCHER_HPP
+#define BATCHER_HPP
+
+#include "util/trt_types.hpp"
+#include "modules.hpp"
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <future>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <span>
+
+namespace trttl {
+
+/*!
+* Backend executing whole batch: `(const float* input, float* output, int32_t n)`.
+* Buffers hold `M::batch_size` rows, only first `n` are meaningful.
+*/
+template<typename B>
+concept BatchBackend = std::invocable<B&, const float*, float*, int32_t>;
+
+/*!
+* Snapshot of batcher statistics.
+*/
+struct BatcherMetrics {
+    uint64_t requests = 0;          /*!< Completed requests.*/
+    uint64_t batches = 0;           /*!< Dispatched batches.*/
+    double mean_fill = 0.0;         /*!< Mean requests per batch / batch_size.*/
+    double mean_wait_us = 0.0;      /*!< Mean time from submit to dispatch.*/
+    uint64_t max_wait_us = 0;
+    uint32_t queue_depth = 0;       /*!< Requests currently waiting for dispatch.*/
+};
+
+/*!
+* Coalesces single-sample requests into batches of up to `M::batch_size`.
+* Samples are copied straight into a contiguous batch buffer on submit; the batch is dispatched
+* when full or when its oldest request waited `deadline`. While one batch runs, the next fills.
+* Results are scattered back through futures.
+*
+* @tparam M - module defining per-sample shapes and max batch
+* @tparam Backend - `BatchBackend` (engine, `CpuExecutor` adapter, stub...)
+*/
+template<DerivedFromModule M, BatchBackend Backend>
+class Batcher {
+public:
+    static constexpr std::size_t input_elems = dimVolume(M::in_shape);
+    static constexpr std::size_t output_elems = dimVolume(M::out_shape);
+    static constexpr int32_t max_batch = M::batch_size;
+
+    using Output = std::array<float, output_elems>;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Batch {
+        std::vector<float> input = std::vector<float>(max_batch * input_elems);
+        std::vector<float> output = std::vector<float>(max_batch * output_elems);
+        std::vector<std::promise<Output>> promises;
+        std::vector<clock::time_point> arrivals;
+        int32_t count = 0;
+
+        Batch() {
+            promises.reserve(max_batch);
+            arrivals.reserve(max_batch);
+        }
+    };
+
+    Backend backend;
+    const clock::duration deadline;
+
+    std::mutex mtx;
+    std::condition_variable ready_cv;                   /*!< Wakes dispatcher.*/
+    std::condition_variable space_cv;                   /*!< Wakes producers blocked on full batch.*/
+    Batch batches[2];
+    int filling = 0;
+    bool stop = false;
+
+    std::atomic<uint64_t> n_requests{0};
+    std::atomic<uint64_t> n_batches{0};
+    std::atomic<uint64_t> wait_ns{0};
+    std::atomic<uint64_t> max_wait_ns{0};
+
+    std::thread dispatcher;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mtx);
+        for (;;) {
+            Batch& b = batches[filling];
+            if (b.count == 0) {
+                if (stop)
+                    return;
+                ready_cv.wait(lock);
+                continue;
+            }
+            if (b.count < max_batch && !stop) {
+                if (ready_cv.wait_until(lock, b.arrivals.front() + deadline) == std::cv_status::no_timeout)
+                    continue;
+                if (clock::now() < b.arrivals.front() + deadline)
+                    continue;
+            }
+
+            filling ^= 1;
+            lock.unlock();
+            space_cv.notify_all();
+            dispatch(b);
+            lock.lock();
+        }
+    }
+
+    void dispatch(Batch& b) {
+        const auto start = clock::now();
+        uint64_t total = 0, worst = 0;
+        for (const auto& t : b.arrivals) {
+            const auto w = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - t).count());
+            total += w;
+            worst = std::max(worst, w);
+        }
+        wait_ns.fetch_add(total, std::memory_order_relaxed);
+        for (uint64_t prev = max_wait_ns.load(); worst > prev && !max_wait_ns.compare_exchange_weak(prev, worst);) {}
+
+        try {
+            backend(b.input.data(), b.output.data(), b.count);
+            for (int32_t i = 0; i < b.count; ++i) {
+                Output o;
+                std::copy_n(b.output.data() + i * output_elems, output_elems, o.begin());
+                b.promises[i].set_value(o);
+            }
+        } catch (...) {
+            for (int32_t i = 0; i < b.count; ++i)
+                b.promises[i].set_exception(std::current_exception());
+        }
+
+        n_requests.fetch_add(b.count, std::memory_order_relaxed);
+        n_batches.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        b.promises.clear();
+        b.arrivals.clear();
+        b.count = 0;
+    }
+
+public:
+    /*!
+    * @param backend - executes batches on dispatcher thread
+    * @param deadline - max time the oldest request waits for the batch to fill
+    */
+    Batcher(Backend backend, std::chrono::microseconds deadline)
+        : backend(std::move(backend)), deadline(deadline), dispatcher([this] { run(); }) {}
+
+    Batcher(const Batcher&) = delete;
+    Batcher& operator=(const Batcher&) = delete;
+
+    /*!
+    * Dispatches remaining requests and stops.
+    */
+    ~Batcher() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+        }
+        ready_cv.notify_all();
+        dispatcher.join();
+    }
+
+    /*!
+    * Enqueues one sample, blocks only if both batch buffers are full.
+    */
+    std::future<Output> submit(std::span<const float, input_elems> sample) {
+        return submit([sample](std::span<float, input_elems> slot) { std::copy(sample.begin(), sample.end(), slot.begin()); });
+    }
+
+    /*!
+    * Enqueues one sample written in place by `fill(slot)` (e.g. `Preprocessor::fill`) - no staging copy.
+    * `fill` runs under the batcher lock, so keep it to producing the sample. If it throws, nothing is enqueued.
+    */
+    template<typename F>
+    requires std::invocable<F&, std::span<float, input_elems>>
+    std::future<Output> submit(F&& fill) {
+        std::unique_lock<std::mutex> lock(mtx);
+        space_cv.wait(lock, [this] { return batches[filling].count < max_batch; });
+
+        Batch& b = batches[filling];
+        fill(std::span<float, input_elems>(b.input.data() + b.count * input_elems, input_elems));
+        b.arrivals.push_back(clock::now());
+        auto future = b.promises.emplace_back().get_future();
+        if (++b.count == 1 || b.count == max_batch)
+            ready_cv.notify_one();
+        return future;
+    }
+
+    BatcherMetrics metrics() {
+        BatcherMetrics m;
+        m.requests = n_requests.load(std::memory_order_relaxed);
+        m.batches = n_batches.load(std::memory_order_relaxed);
+        if (m.batches > 0)
+            m.mean_fill = static_cast<double>(m.requests) / (static_cast<double>(m.batches) * max_batch);
+        if (m.requests > 0)
+            m.mean_wait_us = static_cast<double>(wait_ns.load(std::memory_order_relaxed)) / m.requests / 1000.0;
+        m.max_wait_us = max_wait_ns.load(std::memory_order_relaxed) / 1000;
+        std::lock_guard<std::mutex> lock(mtx);
+        m.queue_depth = static_cast<uint32_t>(batches[0].count + batches[1].count);
+        return m;
+    }
+};
+
+} // trttl namespace
+#endif // BATCHER_HPP
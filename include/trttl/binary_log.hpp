@@ -0,0 +1,310 @@
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+#include "logger.hpp"
+#include <source_location>
+#include <unordered_map>
+#include <string_view>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <ostream>
+#include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+
+namespace trttl {
+
+/*!
+* On-disk layout of `BinaryLog` files (native endianness):
+* - header: magic `TRTTLBL1`, `LogClock` ticks and wall-clock ns taken together, ticks per ns,
+* - site entry (once per call site, before its first message):
+*   `'S'`, 3 pad bytes, u32 id, u32 line, u32 column, u16 file length, u16 function length, file, function,
+* - message entry: `'M'`, u8 severity, u16 length, u32 site id, u64 ticks, message bytes.
+*/
+struct BinaryLogFormat {
+    static constexpr char magic[8] = {'T', 'R', 'T', 'T', 'L', 'B', 'L', '1'};
+    static constexpr std::size_t header_size = 32;
+    static constexpr std::size_t site_size = 20;
+    static constexpr std::size_t message_size = 16;
+    static constexpr char site_tag = 'S';
+    static constexpr char message_tag = 'M';
+    static constexpr std::size_t max_len = UINT16_MAX;
+
+    /*!
+    * `LogClock` ticks per nanosecond, measured once per process against the steady clock.
+    */
+    static double ticks_per_ns() {
+        static const double rate = [] {
+            using clk = std::chrono::steady_clock;
+            const auto s0 = clk::now();
+            const uint64_t t0 = LogClock::now();
+            while (clk::now() - s0 < std::chrono::milliseconds(2)) {}
+            const auto s1 = clk::now();
+            const uint64_t t1 = LogClock::now();
+            return static_cast<double>(t1 - t0) / static_cast<double>(std::chrono::nanoseconds(s1 - s0).count());
+        }();
+        return rate;
+    }
+};
+
+/*!
+* Single binary log file - one per path per process, shared by every `BinaryLog` writing to it.
+*/
+class BinaryLogWriter {
+private:
+    struct Site {
+        const char* file;
+        const char* function;
+        uint32_t line;
+        uint32_t column;
+
+        bool operator==(const Site&) const = default;
+    };
+
+    struct SiteHash {
+        std::size_t operator()(const Site& s) const noexcept {
+            return std::hash<const void*>()(s.file) ^ (std::hash<const void*>()(s.function) << 1) ^
+                   (static_cast<std::size_t>(s.line) << 20) ^ s.column;
+        }
+    };
+
+    std::mutex mtx;                                     /*!< Sinks of different loggers may share file.*/
+    std::vector<char> buffer;
+    std::ofstream fout;
+    std::unordered_map<Site, uint32_t, SiteHash> sites;
+
+    template<typename T>
+    void put(const T& v) {
+        fout.write(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+
+    uint32_t site(const std::source_location& location) {
+        const Site key{location.file_name(), location.function_name(), location.line(), location.column()};
+        const auto [it, added] = sites.try_emplace(key, static_cast<uint32_t>(sites.size()));
+        if (added) {
+            const std::size_t file_len = std::min(std::strlen(key.file), BinaryLogFormat::max_len);
+            const std::size_t func_len = std::min(std::strlen(key.function), BinaryLogFormat::max_len);
+            const char pad[3] = {};
+            fout.put(BinaryLogFormat::site_tag);
+            fout.write(pad, sizeof(pad));
+            put(it->second);
+            put(key.line);
+            put(key.column);
+            put(static_cast<uint16_t>(file_len));
+            put(static_cast<uint16_t>(func_len));
+            fout.write(key.file, static_cast<std::streamsize>(file_len));
+            fout.write(key.function, static_cast<std::streamsize>(func_len));
+        }
+        return it->second;
+    }
+
+public:
+    explicit BinaryLogWriter(const std::string& path) : buffer(1 << 16) {
+        fout.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        fout.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!fout.is_open())
+            throw std::ios_base::failure("Failed to open binary log file!");
+
+        const double rate = BinaryLogFormat::ticks_per_ns();
+        const uint64_t ticks = LogClock::now();
+        const int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        fout.write(BinaryLogFormat::magic, sizeof(BinaryLogFormat::magic));
+        put(ticks);
+        put(wall);
+        put(rate);
+    }
+
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    /*!
+    * Writer for `path`, opened (and truncated) if no sink holds it yet.
+    */
+    static std::shared_ptr<BinaryLogWriter> open(const std::string& path) {
+        static std::mutex registry_mtx;
+        static std::unordered_map<std::string, std::weak_ptr<BinaryLogWriter>> registry;
+        std::lock_guard<std::mutex> lock(registry_mtx);
+        auto& slot = registry[path];
+        auto writer = slot.lock();
+        if (!writer) {
+            writer = std::make_shared<BinaryLogWriter>(path);
+            slot = writer;
+        }
+        return writer;
+    }
+
+    void record(uint32_t severity, uint64_t ticks, const std::source_location& location, const char* msg) {
+        const std::size_t len = std::min(std::strlen(msg), BinaryLogFormat::max_len);
+        std::lock_guard<std::mutex> lock(mtx);
+        const uint32_t id = site(location);
+        fout.put(BinaryLogFormat::message_tag);
+        fout.put(static_cast<char>(severity));
+        put(static_cast<uint16_t>(len));
+        put(id);
+        put(ticks);
+        fout.write(msg, static_cast<std::streamsize>(len));
+        if (severity <= cexpr_utils::to_underlying(trt_types::Severity::kERROR))
+            fout.flush();
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(mtx);
+        fout.flush();
+    }
+};
+
+/*!
+* Binary sink - stores call-site id, severity, raw `LogClock` ticks and message bytes;
+* formatting is deferred to `BinaryLogReader` (see `trttl_logdecode`). Call-site metadata is
+* written once per site. Records are buffered and flushed on errors, `flush()` and when the last
+* sink of a file goes away. Drop-in replacement for `FileLog` in `Logger<...>` and `AsyncLogger<...>`.
+*/
+class BinaryLog : public LogStream<BinaryLog> {
+private:
+    std::shared_ptr<BinaryLogWriter> writer;
+    std::ostream cnull{0};
+
+public:
+    BinaryLog() : BinaryLog("trt.blog") {}
+
+    explicit BinaryLog(const std::string& path) : writer(BinaryLogWriter::open(path)) {}
+
+    /*!
+    * Text interface for `LogStream` compatibility - discards output.
+    */
+    std::ostream& get_impl() {
+        return cnull;
+    }
+
+    void record(uint32_t severity, uint64_t ticks, const std::source_location& location, const char* msg) {
+        writer->record(severity, ticks, location, msg);
+    }
+
+    void flush() {
+        writer->flush();
+    }
+};
+
+/*!
+* Reads `BinaryLog` files back. A truncated trailing record (crash mid-write) is ignored,
+* anything else malformed throws.
+*/
+class BinaryLogReader {
+public:
+    struct Site {
+        std::string file;
+        std::string function;
+        uint32_t line;
+        uint32_t column;
+    };
+
+    struct Entry {
+        uint32_t severity;
+        const Site* site;
+        int64_t wall_ns;                                /*!< Wall-clock time reconstructed from ticks.*/
+        std::string_view msg;
+    };
+
+private:
+    std::vector<char> data;
+    std::deque<Site> sites;                             /*!< Stable addresses for `Entry::site`.*/
+    uint64_t ticks0 = 0;
+    int64_t wall0 = 0;
+    double rate = 1.0;
+
+    template<typename T>
+    T get(std::size_t offset) const {
+        T v;
+        std::memcpy(&v, data.data() + offset, sizeof(T));
+        return v;
+    }
+
+public:
+    explicit BinaryLogReader(const std::string& path) {
+        std::ifstream fin(path, std::ios::binary);
+        if (!fin)
+            throw std::ios_base::failure("Failed to open binary log file: " + path);
+        data.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        if (data.size() < BinaryLogFormat::header_size ||
+            std::memcmp(data.data(), BinaryLogFormat::magic, sizeof(BinaryLogFormat::magic)) != 0)
+            throw std::runtime_error("Not a binary log file: " + path);
+        ticks0 = get<uint64_t>(8);
+        wall0 = get<int64_t>(16);
+        rate = get<double>(24);
+        if (!(rate > 0.0))
+            throw std::runtime_error("Invalid clock calibration in: " + path);
+    }
+
+    /*!
+    * Calls `f(const Entry&)` for every message in file order.
+    */
+    template<typename F>
+    void for_each(F&& f) {
+        sites.clear();
+        std::size_t pos = BinaryLogFormat::header_size;
+        while (pos < data.size()) {
+            const char tag = data[pos];
+            if (tag == BinaryLogFormat::site_tag) {
+                if (pos + BinaryLogFormat::site_size > data.size())
+                    return;
+                const auto id = get<uint32_t>(pos + 4);
+                const auto file_len = get<uint16_t>(pos + 16), func_len = get<uint16_t>(pos + 18);
+                const std::size_t body = pos + BinaryLogFormat::site_size;
+                if (body + file_len + func_len > data.size())
+                    return;
+                if (id != sites.size())
+                    throw std::runtime_error("Binary log site table out of order.");
+                sites.push_back({std::string(data.data() + body, file_len), std::string(data.data() + body + file_len, func_len),
+                                 get<uint32_t>(pos + 8), get<uint32_t>(pos + 12)});
+                pos = body + file_len + func_len;
+            } else if (tag == BinaryLogFormat::message_tag) {
+                if (pos + BinaryLogFormat::message_size > data.size())
+                    return;
+                const auto severity = static_cast<uint32_t>(static_cast<unsigned char>(data[pos + 1]));
+                const auto len = get<uint16_t>(pos + 2);
+                const auto id = get<uint32_t>(pos + 4);
+                const auto ticks = get<uint64_t>(pos + 8);
+                const std::size_t body = pos + BinaryLogFormat::message_size;
+                if (body + len > data.size())
+                    return;
+                if (id >= sites.size() || severity >= 5)
+                    throw std::runtime_error("Corrupt binary log record.");
+                const double delta = static_cast<double>(static_cast<int64_t>(ticks - ticks0)) / rate;
+                f(Entry{severity, &sites[id], wall0 + static_cast<int64_t>(delta), std::string_view(data.data() + body, len)});
+                pos = body + len;
+            } else {
+                throw std::runtime_error("Corrupt binary log record.");
+            }
+        }
+    }
+
+    /*!
+    * Writes messages in `LogFormat` text layout, one per line. Returns number of messages.
+    */
+    std::size_t decode(std::ostream& out) {
+        std::size_t n = 0;
+        for_each([&](const Entry& e) {
+            const std::time_t time = static_cast<std::time_t>(e.wall_ns / 1000000000);
+            LogFormat::write<std::string_view>(out, e.severity, time, e.site->file, e.site->line, e.site->column,
+                                               e.site->function, e.msg);
+            out << '\n';
+            ++n;
+        });
+        return n;
+    }
+
+    std::size_t siteCount() const noexcept { return sites.size(); }
+};
+
+} // trttl namespace
+#endif // BINARY_LOG_HPP
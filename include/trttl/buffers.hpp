@@ -0,0 +1,167 @@
+#ifndef BUFFERS_HPP
+#define BUFFERS_HPP
+
+#include "util/mpsc_queue.hpp"
+#include "util/trt_types.hpp"
+#include "modules.hpp"
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <atomic>
+#include <array>
+#include <span>
+
+namespace trttl {
+
+/*!
+* Fixed-size, 64-byte aligned host tensor of `batch` samples shaped `shape`.
+* Size, strides and element type are compile-time, so buffers can't be mismatched with modules.
+*
+* @tparam T - element type
+* @tparam shape - per-sample dimensions
+* @tparam batch - number of samples
+*/
+template<typename T, trt_types::Dims shape, int32_t batch>
+requires (batch > 0 && dimVolume(shape) > 0)
+struct alignas(64) TensorBuffer {
+    using value_type = T;
+
+    static constexpr trt_types::Dims sample_shape = shape;
+    static constexpr trt_types::Dims sample_strides = dimStrides(shape);
+    static constexpr int32_t batch_size = batch;
+    static constexpr std::size_t sample_size = static_cast<std::size_t>(dimVolume(shape));
+    static constexpr std::size_t size = sample_size * batch;
+    static constexpr std::size_t bytes = size * sizeof(T);
+
+    std::array<T, size> values;
+
+    T* data() noexcept { return values.data(); }
+    const T* data() const noexcept { return values.data(); }
+    T* begin() noexcept { return values.data(); }
+    T* end() noexcept { return values.data() + size; }
+    const T* begin() const noexcept { return values.data(); }
+    const T* end() const noexcept { return values.data() + size; }
+    T& operator[](std::size_t i) noexcept { return values[i]; }
+    const T& operator[](std::size_t i) const noexcept { return values[i]; }
+
+    std::span<T, sample_size> sample(int32_t i) noexcept {
+        return std::span<T, sample_size>(values.data() + i * sample_size, sample_size);
+    }
+    std::span<const T, sample_size> sample(int32_t i) const noexcept {
+        return std::span<const T, sample_size>(values.data() + i * sample_size, sample_size);
+    }
+};
+
+/*!
+* Engine/executor input for whole `M` batch (bindings are kFLOAT, see `Network::build`).
+*/
+template<DerivedFromModule M>
+using InputBuffer = TensorBuffer<float, M::in_shape, M::batch_size>;
+
+/*!
+* Engine/executor output for whole `M` batch.
+*/
+template<DerivedFromModule M>
+using OutputBuffer = TensorBuffer<float, M::out_shape, M::batch_size>;
+
+/*!
+* Fixed pool of `capacity` buffers allocated once up front.
+* `acquire()`/release are lock-free (free-list of indices) and never touch the heap,
+* so pools can sit on the request path of serving loops.
+*
+* @tparam B - buffer type (e.g. `InputBuffer<M>`)
+* @tparam capacity - number of buffers, power of two
+*/
+template<typename B, std::size_t capacity>
+requires (std::is_trivially_destructible_v<B>)
+class BufferPool {
+private:
+    std::unique_ptr<B[]> storage;
+    conc_utils::MPSCQueue<uint32_t, capacity> free_list;
+    alignas(conc_utils::cache_line) std::atomic<uint32_t> n_free{0};
+
+    void release(B* b) noexcept {
+        n_free.fetch_add(1, std::memory_order_relaxed);         // before push, so counter never underflows
+        free_list.try_push(static_cast<uint32_t>(b - storage.get()));
+        n_free.notify_one();
+    }
+
+public:
+    /*!
+    * Exclusive handle to pooled buffer, returned to pool on destruction.
+    */
+    class Lease {
+    private:
+        friend class BufferPool;
+        BufferPool* pool = nullptr;
+        B* buffer = nullptr;
+
+        Lease(BufferPool* p, B* b) noexcept : pool(p), buffer(b) {}
+
+    public:
+        Lease() = default;
+        Lease(Lease&& o) noexcept : pool(std::exchange(o.pool, nullptr)), buffer(std::exchange(o.buffer, nullptr)) {}
+        Lease& operator=(Lease&& o) noexcept {
+            if (this != &o) {
+                reset();
+                pool = std::exchange(o.pool, nullptr);
+                buffer = std::exchange(o.buffer, nullptr);
+            }
+            return *this;
+        }
+        ~Lease() { reset(); }
+
+        void reset() noexcept {
+            if (buffer)
+                pool->release(buffer);
+            pool = nullptr;
+            buffer = nullptr;
+        }
+
+        B& operator*() const noexcept { return *buffer; }
+        B* operator->() const noexcept { return buffer; }
+        B* get() const noexcept { return buffer; }
+        explicit operator bool() const noexcept { return buffer != nullptr; }
+    };
+
+    BufferPool() : storage(std::make_unique<B[]>(capacity)) {
+        for (uint32_t i = 0; i < capacity; ++i)
+            free_list.try_push(i);
+        n_free.store(capacity, std::memory_order_relaxed);
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /*!
+    * Returns empty lease if pool is exhausted.
+    */
+    Lease try_acquire() noexcept {
+        uint32_t i;
+        if (!free_list.try_pop(i))
+            return Lease();
+        n_free.fetch_sub(1, std::memory_order_relaxed);
+        return Lease(this, storage.get() + i);
+    }
+
+    /*!
+    * Blocks until a buffer is returned.
+    */
+    Lease acquire() noexcept {
+        for (;;) {
+            if (Lease l = try_acquire())
+                return l;
+            n_free.wait(0, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t available() const noexcept { return n_free.load(std::memory_order_relaxed); }
+
+    static constexpr std::size_t size = capacity;
+};
+
+} // trttl namespace
+#endif // BUFFERS_HPP
@@ -0,0 +1,107 @@
+#ifndef BUILD_POLICY_HPP
+#define BUILD_POLICY_HPP
+
+#include "util/hash_utils.hpp"
+#include "util/cexpr_utils.hpp"
+#include <NvInfer.h>
+#include <NvInferVersion.h>
+#include <string_view>
+#include <sstream>
+#include <cstdint>
+#include <string>
+
+namespace trttl {
+
+/*!
+* Builder settings applied by `Network<M, policy>` on top of the precision flags implied by the module.
+* Structural, so it can be a template argument - plans built with different policies get different keys.
+* Sentinel values (0 / -1) keep TensorRT defaults.
+*/
+struct BuildPolicy {
+    char name[16] = "default";                          /*!< Recorded with the plan.*/
+    uint64_t workspace_bytes = 0;                       /*!< `kWORKSPACE` pool limit, 0 - device memory.*/
+    int32_t optimization_level = -1;                    /*!< 0 (fastest build) - 5 (most tactics), -1 - TRT default (3).*/
+    int64_t tactic_sources = -1;                        /*!< Mask of `1 << TacticSource`, -1 - TRT defaults.*/
+    uint32_t preview_enable = 0;                        /*!< Mask of `1 << PreviewFeature`.*/
+    uint32_t preview_disable = 0;
+    nvinfer1::HardwareCompatibilityLevel hardware_compatibility = nvinfer1::HardwareCompatibilityLevel::kNONE;
+    bool intern_weights = false;                        /*!< Share parameter memory across networks via `WeightRegistry::global()`.*/
+
+    /*!
+    * Mask of enum bits - `BuildPolicy::mask(TacticSource::kCUBLAS, TacticSource::kCUBLAS_LT)`.
+    */
+    template<typename... E>
+    static constexpr uint32_t mask(E... bits) {
+        return (0u | ... | (1u << static_cast<uint32_t>(cexpr_utils::to_underlying(bits))));
+    }
+
+    constexpr uint64_t hash() const {
+        uint64_t h = hash_utils::fnv1a(name);
+        h = hash_utils::combine(h, workspace_bytes);
+        h = hash_utils::combine(h, static_cast<uint64_t>(optimization_level));
+        h = hash_utils::combine(h, static_cast<uint64_t>(tactic_sources));
+        h = hash_utils::combine(h, (static_cast<uint64_t>(preview_enable) << 32) | preview_disable);
+        h = hash_utils::combine(h, static_cast<uint64_t>(cexpr_utils::to_underlying(hardware_compatibility)));
+        return hash_utils::combine(h, static_cast<uint64_t>(intern_weights));
+    }
+
+    void apply(nvinfer1::IBuilderConfig& config) const {
+        if (workspace_bytes)
+            config.setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, workspace_bytes);
+        if (optimization_level >= 0)
+            config.setBuilderOptimizationLevel(optimization_level);
+        if (tactic_sources >= 0)
+            config.setTacticSources(static_cast<nvinfer1::TacticSources>(tactic_sources));
+        for (uint32_t f = 0; f < 32; ++f) {
+            if (preview_enable & (1u << f))
+                config.setPreviewFeature(static_cast<nvinfer1::PreviewFeature>(f), true);
+            else if (preview_disable & (1u << f))
+                config.setPreviewFeature(static_cast<nvinfer1::PreviewFeature>(f), false);
+        }
+        config.setHardwareCompatibilityLevel(hardware_compatibility);
+    }
+};
+
+namespace build_policies {
+    /*!
+    * TensorRT defaults.
+    */
+    inline constexpr BuildPolicy standard{};
+
+    /*!
+    * Fast iteration - least tactic search, workspace capped so several builds fit on one GPU.
+    */
+    inline constexpr BuildPolicy dev{.name = "dev", .workspace_bytes = 1ull << 30, .optimization_level = 0};
+
+    /*!
+    * Deployment - exhaustive tactic search with the whole device as workspace, engine tied to the build GPU.
+    */
+    inline constexpr BuildPolicy prod{.name = "prod", .optimization_level = 5};
+} // build_policies namespace
+
+/*!
+* Effective builder config as one-line JSON - read back from `config`, so `builderConfig()` tweaks are included.
+*/
+inline std::string describeConfig(nvinfer1::IBuilderConfig& config, std::string_view policy) {
+    uint32_t flags = 0;
+    for (int32_t f = 0; f <= static_cast<int32_t>(nvinfer1::BuilderFlag::kFP8); ++f)
+        if (config.getFlag(static_cast<nvinfer1::BuilderFlag>(f)))
+            flags |= 1u << f;
+    uint32_t preview = 0;
+    for (int32_t f = 0; f <= static_cast<int32_t>(nvinfer1::PreviewFeature::kPROFILE_SHARING_0806); ++f)
+        if (config.getPreviewFeature(static_cast<nvinfer1::PreviewFeature>(f)))
+            preview |= 1u << f;
+
+    std::ostringstream out;
+    out << "{\"policy\": \"" << policy << "\", \"tensorrt\": \"" << NV_TENSORRT_MAJOR << '.' << NV_TENSORRT_MINOR << '.'
+        << NV_TENSORRT_PATCH << "\", \"optimization_level\": " << config.getBuilderOptimizationLevel()
+        << ", \"workspace_bytes\": " << config.getMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE)
+        << ", \"tactic_sources\": " << static_cast<uint32_t>(config.getTacticSources())
+        << ", \"preview_features\": " << preview
+        << ", \"hardware_compatibility\": " << static_cast<int32_t>(config.getHardwareCompatibilityLevel())
+        << ", \"builder_flags\": " << flags << "}";
+    return out.str();
+}
+
+} // trttl namespace
+#endif // BUILD_POLICY_HPP
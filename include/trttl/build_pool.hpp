@@ -0,0 +1,284 @@
+#ifndef BUILD_POOL_HPP
+#define BUILD_POOL_HPP
+
+#include "timing_cache.hpp"
+#include "plan_cache.hpp"
+#include "modules.hpp"
+#include "utils.hpp"
+#include <condition_variable>
+#include <NvInfer.h>
+#include <stdexcept>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <memory>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace trttl {
+
+/*!
+* Thrown from `BuildJob::get()` when a job was cancelled before producing a plan.
+*/
+class BuildCancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/*!
+* Build progress callbacks, shaped after TensorRT 10 `IProgressMonitor`.
+* Every job is a phase named after the job with steps `define`, `configure`, `build`;
+* returning false from `stepComplete` cancels the job. Called from pool threads concurrently.
+*/
+class BuildMonitor {
+public:
+    virtual ~BuildMonitor() = default;
+    virtual void phaseStart(const char* /*phase*/, const char* /*parent*/, int32_t /*steps*/) noexcept {}
+    virtual bool stepComplete(const char* /*phase*/, int32_t /*step*/) noexcept { return true; }
+    virtual void phaseFinish(const char* /*phase*/) noexcept {}
+};
+
+/*!
+* Per-job build options - pointed-to objects must outlive the job.
+*/
+struct BuildOptions {
+    std::string name;                               /*!< Phase name reported to monitor, defaults to fingerprint.*/
+    PlanCache* plan_cache = nullptr;                /*!< Probed first, records plans with their builder config.*/
+    TimingCache* timing_cache = nullptr;
+    BuildMonitor* monitor = nullptr;
+};
+
+/*!
+* Handle of a submitted build.
+*/
+class BuildJob {
+private:
+    std::future<Plan> result;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+
+public:
+    BuildJob(std::future<Plan> result, std::shared_ptr<std::atomic<bool>> cancelled)
+        : result(std::move(result)), cancelled(std::move(cancelled)) {}
+
+    /*!
+    * Requests cancellation. Queued jobs never start; running ones stop at the next step boundary
+    * (TensorRT 8.6 can't interrupt the builder itself, its result is then discarded).
+    */
+    void cancel() noexcept { cancelled->store(true, std::memory_order_relaxed); }
+
+    bool valid() const noexcept { return result.valid(); }
+    void wait() const { result.wait(); }
+
+    /*!
+    * Serialized plan; rethrows build errors or `BuildCancelled`.
+    */
+    Plan get() { return result.get(); }
+};
+
+/*!
+* Fixed-size thread pool building many `Network`s concurrently - startup takes the longest build
+* instead of the sum of all of them. Each job owns its builder; the logger must be thread-safe.
+* Destruction cancels queued jobs and waits for running ones.
+*/
+class BuildPool {
+private:
+    struct Task {
+        std::shared_ptr<std::atomic<bool>> cancelled;
+
+        virtual ~Task() = default;
+        virtual void run() = 0;
+        virtual void abandon() = 0;
+    };
+
+    template<BuildPolicy policy, DerivedFromModule M, typename Setup>
+    struct NetworkTask : Task {
+        nvinfer1::ILogger& logger;
+        M module;
+        BuildOptions options;
+        Setup setup;
+        std::promise<Plan> promise;
+
+        NetworkTask(nvinfer1::ILogger& logger, M module, BuildOptions options, Setup setup)
+            : logger(logger), module(std::move(module)), options(std::move(options)), setup(std::move(setup)) {}
+
+        /*!
+        * Reports finished step, false when job should stop.
+        */
+        bool step(int32_t i) {
+            if (options.monitor && !options.monitor->stepComplete(options.name.c_str(), i))
+                this->cancelled->store(true, std::memory_order_relaxed);
+            return !this->cancelled->load(std::memory_order_relaxed);
+        }
+
+        void run() override {
+            TraceSpan span("job", "BuildPool::job", options.name);
+            auto* monitor = options.monitor;
+            if (monitor)
+                monitor->phaseStart(options.name.c_str(), nullptr, 3);
+            Plan plan;
+            std::exception_ptr error;
+            try {
+                if (!this->cancelled->load(std::memory_order_relaxed)) {
+                    // Probe before defining the network - a hit completes every step without a builder
+                    const uint64_t key = options.plan_cache ? Network<M, policy>::planKey(module) : 0;
+                    std::optional<Plan> cached = options.plan_cache ? options.plan_cache->get(key) : std::nullopt;
+                    if (cached) {
+                        plan = std::move(*cached);
+                        for (int32_t i = 0; i < 3 && step(i); ++i) {}
+                    } else {
+                        Network<M, policy> network(logger, std::move(module));
+                        if (step(0)) {
+                            setup(network);
+                            network.setTimingCache(options.timing_cache);
+                            if (step(1)) {
+                                if (options.plan_cache) {
+                                    plan = network.store(*options.plan_cache, key);
+                                } else {
+                                    auto memory = network.serialize();
+                                    if (!memory)
+                                        throw std::runtime_error("Engine build failed: " + options.name);
+                                    TraceSpan copy("serialize", "BuildPool::copyPlan", options.name);
+                                    const auto* p = static_cast<const char*>(memory->data());
+                                    plan.assign(p, p + memory->size());
+                                }
+                                step(2);
+                            }
+                        }
+                    }
+                }
+                if (this->cancelled->load(std::memory_order_relaxed))
+                    throw BuildCancelled("Build cancelled: " + options.name);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            if (monitor)
+                monitor->phaseFinish(options.name.c_str());
+            if (error)
+                promise.set_exception(error);
+            else
+                promise.set_value(std::move(plan));
+        }
+
+        void abandon() override {
+            promise.set_exception(std::make_exception_ptr(BuildCancelled("Build cancelled: " + options.name)));
+        }
+    };
+
+    /*!
+    * Default job setup - no extra configuration.
+    */
+    struct NoSetup {
+        template<typename N>
+        void operator()(N&) const noexcept {}
+    };
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable idle;
+    std::deque<std::unique_ptr<Task>> queue;
+    std::size_t running = 0;
+    bool stop = false;
+    std::vector<std::thread> workers;
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            cv.wait(lock, [this] { return stop || !queue.empty(); });
+            if (queue.empty())
+                return;
+            auto task = std::move(queue.front());
+            queue.pop_front();
+            ++running;
+            lock.unlock();
+
+            if (task->cancelled->load(std::memory_order_relaxed))
+                task->abandon();
+            else
+                task->run();
+            task.reset();
+
+            lock.lock();
+            if (--running == 0 && queue.empty())
+                idle.notify_all();
+        }
+    }
+
+public:
+    /*!
+    * @param threads - concurrent builds; each holds a builder and its GPU workspace, so keep it small
+    */
+    explicit BuildPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency() / 2)) {
+        if (threads == 0)
+            throw std::invalid_argument("BuildPool needs at least one thread.");
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            workers.emplace_back(&BuildPool::work, this);
+    }
+
+    BuildPool(const BuildPool&) = delete;
+    BuildPool& operator=(const BuildPool&) = delete;
+
+    ~BuildPool() {
+        std::deque<std::unique_ptr<Task>> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+            dropped.swap(queue);
+        }
+        cv.notify_all();
+        for (auto& task : dropped)
+            task->abandon();
+        for (auto& w : workers)
+            w.join();
+    }
+
+    /*!
+    * Queues build of `module`; `setup(Network<M, policy>&)` runs on the pool thread before serialization
+    * (calibrator, builder config tuning...). Without `options.plan_cache` the job returns engine bytes only -
+    * capture `configJson()` in `setup` to keep the config.
+    */
+    template<BuildPolicy policy = build_policies::standard, DerivedFromModule M, typename Setup = NoSetup>
+    BuildJob submit(nvinfer1::ILogger& logger, M module, BuildOptions options = {}, Setup setup = {}) {
+        if (options.name.empty()) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(M::fingerprint()));
+            options.name = name;
+        }
+        auto task = std::make_unique<NetworkTask<policy, M, Setup>>(logger, std::move(module), std::move(options), std::move(setup));
+        task->cancelled = std::make_shared<std::atomic<bool>>(false);
+        BuildJob job(task->promise.get_future(), task->cancelled);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (stop)
+                throw std::runtime_error("BuildPool is shutting down.");
+            queue.push_back(std::move(task));
+        }
+        cv.notify_one();
+        return job;
+    }
+
+    /*!
+    * Blocks until every queued and running job has finished.
+    */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx);
+        idle.wait(lock, [this] { return queue.empty() && running == 0; });
+    }
+
+    std::size_t pending() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return queue.size() + running;
+    }
+};
+
+} // trttl namespace
+#endif // BUILD_POOL_HPP
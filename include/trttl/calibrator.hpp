@@ -0,0 +1,215 @@
+#ifndef CALIBRATOR_HPP
+#define CALIBRATOR_HPP
+
+#include "util/file_utils.hpp"
+#include "util/trt_types.hpp"
+#include "modules.hpp"
+#include "weights.hpp"
+#include <cuda_runtime_api.h>
+#include <NvInfer.h>
+#include <filesystem>
+#include <stdexcept>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace trttl {
+
+/*!
+* INT8 entropy calibrator streaming samples of `M::in_shape` from disk.
+* Files are raw little-endian fp32 or `.npy` (`<f4`, C order) and are read as one concatenated
+* stream. Memory stays bounded by one batch on host and device; pages already consumed are
+* dropped from the page cache. Incomplete trailing batch is skipped.
+* Files are validated on construction; errors hit while calibrating end calibration and are kept in `error()`.
+*
+* @tparam M - module being calibrated; batch is the kOPT size of its range (calibration profile)
+*/
+template<DerivedFromModule M>
+class StreamingCalibrator : public nvinfer1::IInt8EntropyCalibrator2 {
+public:
+    static constexpr int32_t batch_rows = M::batch_range.opt;
+    static constexpr std::size_t batch_floats = static_cast<std::size_t>(batch_rows) * dimVolume(M::in_shape);
+
+private:
+    std::vector<std::filesystem::path> files;
+    std::filesystem::path cache_path;
+    std::size_t max_batches;
+
+    std::size_t file_idx = 0;
+    int fd = -1;
+    off_t offset = 0;
+    std::size_t served = 0;
+
+    std::vector<float> host;
+    void* device = nullptr;
+    std::vector<char> cache;
+    std::exception_ptr failure;
+
+    /*!
+    * Byte offset of sample data - past the header for `.npy`, which must be C-ordered `<f4`.
+    */
+    static off_t dataOffset(int fd, const std::filesystem::path& path) {
+        unsigned char head[4096];
+        const ssize_t n = ::pread(fd, head, sizeof(head), 0);
+        if (n < 0)
+            throw std::ios_base::failure("Failed to read calibration file: " + path.string());
+        if (n < 6 || std::memcmp(head, "\x93NUMPY", 6) != 0)
+            return 0;
+        const NpyHeader h = parseNpyHeader(head, static_cast<std::size_t>(n), path.string());
+        if (h.descr != "<f4" || h.fortran)
+            throw std::runtime_error("Calibration .npy must be C-ordered <f4: " + path.string());
+        return static_cast<off_t>(h.offset);
+    }
+
+    void closeFile() {
+        if (fd >= 0) {
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+        fd = -1;
+    }
+
+    /*!
+    * Opens next file and positions after `.npy` header if present.
+    */
+    bool openNext() {
+        closeFile();
+        if (file_idx >= files.size())
+            return false;
+        const auto& path = files[file_idx++];
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::ios_base::failure("Failed to open calibration file: " + path.string());
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        offset = dataOffset(fd, path);
+        return true;
+    }
+
+    /*!
+    * Fills `host` with next batch, false when data runs out.
+    */
+    bool readBatch() {
+        auto* dst = reinterpret_cast<char*>(host.data());
+        std::size_t left = batch_floats * sizeof(float);
+        while (left > 0) {
+            if (fd < 0 && !openNext())
+                return false;
+            const ssize_t r = ::pread(fd, dst, left, offset);
+            if (r < 0)
+                throw std::ios_base::failure("Failed to read calibration file.");
+            if (r == 0) {
+                closeFile();
+                continue;
+            }
+            ::posix_fadvise(fd, 0, offset, POSIX_FADV_DONTNEED);
+            offset += r;
+            dst += r;
+            left -= static_cast<std::size_t>(r);
+        }
+        return true;
+    }
+
+public:
+    /*!
+    * @param files - calibration data, read in order
+    * @param cache_path - calibration table; when present calibration data is not read at all
+    * @param max_batches - cap on number of batches served
+    * @throws std::ios_base::failure if a file can't be opened, std::runtime_error if its header or size is invalid
+    */
+    explicit StreamingCalibrator(std::vector<std::filesystem::path> files, std::filesystem::path cache_path = {},
+                                 std::size_t max_batches = SIZE_MAX)
+        : files(std::move(files)), cache_path(std::move(cache_path)), max_batches(max_batches), host(batch_floats) {
+        for (const auto& path : this->files) {
+            const int f = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (f < 0)
+                throw std::ios_base::failure("Failed to open calibration file: " + path.string());
+            off_t data = 0;
+            try {
+                data = dataOffset(f, path);
+            } catch (...) {
+                ::close(f);
+                throw;
+            }
+            const off_t size = ::lseek(f, 0, SEEK_END);
+            ::close(f);
+            if (size < data || (size - data) % static_cast<off_t>(sizeof(float)) != 0)
+                throw std::runtime_error("Calibration file size is not a whole number of floats: " + path.string());
+        }
+        if (cudaMalloc(&device, batch_floats * sizeof(float)) != cudaSuccess)
+            throw std::runtime_error("Failed to allocate calibration device buffer.");
+    }
+
+    StreamingCalibrator(const StreamingCalibrator&) = delete;
+    StreamingCalibrator& operator=(const StreamingCalibrator&) = delete;
+
+    ~StreamingCalibrator() override {
+        closeFile();
+        cudaFree(device);
+    }
+
+    /*!
+    * Explicit batch network - batch dimension comes from the calibration profile.
+    */
+    int32_t getBatchSize() const noexcept override {
+        return 1;
+    }
+
+    bool getBatch(void* bindings[], char const* [], int32_t nbBindings) noexcept override {
+        if (served >= max_batches || nbBindings < 1)
+            return false;
+        if (failure)
+            return false;
+        try {
+            if (!readBatch())
+                return false;
+            if (cudaMemcpy(device, host.data(), batch_floats * sizeof(float), cudaMemcpyHostToDevice) != cudaSuccess)
+                throw std::runtime_error("Failed to copy calibration batch to device.");
+        } catch (...) {
+            failure = std::current_exception();
+            return false;
+        }
+        bindings[0] = device;
+        ++served;
+        return true;
+    }
+
+    void const* readCalibrationCache(std::size_t& length) noexcept override {
+        length = 0;
+        if (cache_path.empty())
+            return nullptr;
+        std::ifstream fin(cache_path, std::ios::binary);
+        if (!fin)
+            return nullptr;
+        cache.assign(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+        length = cache.size();
+        return length ? cache.data() : nullptr;
+    }
+
+    void writeCalibrationCache(void const* ptr, std::size_t length) noexcept override {
+        if (cache_path.empty())
+            return;
+        try {
+            file_utils::atomic_write(cache_path, {{ptr, length}});
+        } catch (...) {
+            failure = std::current_exception();
+        }
+    }
+
+    std::size_t batches() const noexcept { return served; }
+
+    /*!
+    * First read, device copy or cache write error - TensorRT only sees calibration ending early.
+    * Check after `serialize()`; null when calibration went through.
+    */
+    std::exception_ptr error() const noexcept { return failure; }
+};
+
+} // trttl namespace
+#endif // CALIBRATOR_HPP
@@ -0,0 +1,75 @@
+#ifndef CPU_EXECUTOR_HPP
+#define CPU_EXECUTOR_HPP
+
+#include "util/simd_utils.hpp"
+#include "util/trt_types.hpp"
+#include "modules.hpp"
+#include "buffers.hpp"
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <memory>
+#include <new>
+
+namespace trttl {
+
+/*!
+* CPU lowering target for modules - fallback when GPUs are saturated and golden reference in tests.
+* Kernels are specialized on the module's compile-time shapes and batch size.
+* Scratch is allocated once per executor and shared by all layers (ping-pong buffers),
+* so `run()` never allocates.
+*
+* @tparam M - module (kFLOAT, built from Sequential/Linear/Activation/Softmax layers)
+* @tparam V - `simd_utils` instruction set, widest enabled at compile time by default
+*/
+template<DerivedFromModule M, typename V = simd_utils::Native>
+class CpuExecutor {
+private:
+    struct AlignedFree {
+        void operator()(float* p) const noexcept { std::free(p); }
+    };
+
+    M module;
+    std::unique_ptr<float, AlignedFree> scratch;
+
+    static float* allocate(std::size_t floats) {
+        if (floats == 0)
+            return nullptr;
+        const std::size_t bytes = (floats * sizeof(float) + 63) / 64 * 64;
+        auto* p = static_cast<float*>(std::aligned_alloc(64, bytes));
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+public:
+    static constexpr std::size_t input_size = static_cast<std::size_t>(M::batch_size) * dimVolume(M::in_shape);
+    static constexpr std::size_t output_size = static_cast<std::size_t>(M::batch_size) * dimVolume(M::out_shape);
+    static constexpr std::size_t scratch_size = M::workspace();
+
+    CpuExecutor() : scratch(allocate(scratch_size)) {}
+    explicit CpuExecutor(M m) : module(std::move(m)), scratch(allocate(scratch_size)) {}
+
+    /*!
+    * Runs whole batch: `input` holds `input_size` floats, `output` receives `output_size`.
+    * Not thread-safe (shared scratch) - use one executor per thread.
+    */
+    void run(const float* input, float* output) {
+        module.template forward<V>(input, output, scratch.get());
+    }
+
+    void run(const InputBuffer<M>& input, OutputBuffer<M>& output) {
+        run(input.data(), output.data());
+    }
+
+    /*!
+    * `BatchBackend` interface - computes all `M::batch_size` rows regardless of `n`.
+    */
+    void operator()(const float* input, float* output, int32_t) {
+        run(input, output);
+    }
+};
+
+} // trttl namespace
+#endif // CPU_EXECUTOR_HPP
@@ -0,0 +1,186 @@
+#ifndef LOG_LIMITER_HPP
+#define LOG_LIMITER_HPP
+
+#include "util/trt_types.hpp"
+#include "util/cexpr_utils.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <array>
+#include <mutex>
+
+namespace trttl {
+
+/*!
+* Admission limits of one rule - sampling is applied first, then the token bucket.
+*/
+struct LogLimit {
+    uint32_t sample_every = 1;      /*!< Keep 1 in N messages.*/
+    double rate = 0.0;              /*!< Messages per second, 0 - unlimited.*/
+    double burst = 1.0;             /*!< Messages admitted at once before `rate` kicks in.*/
+};
+
+/*!
+* Per-severity / per-message-prefix sampling and rate limiting for loggers.
+* Decision is lock-free (one counter, one CAS on a GCRA token bucket) and made before
+* any formatting or locking; with no rules it's a single atomic load.
+* Rules are append-only, the first prefix rule matching a message wins over the severity-wide one.
+* Dropped messages are counted per rule and reported as one summary before the next admitted one.
+*/
+class LogLimiter {
+public:
+    static constexpr std::size_t max_rules = 32;
+    static constexpr std::size_t max_prefix = 63;
+
+private:
+    struct Rule {
+        uint32_t severity = 0;
+        char prefix[max_prefix + 1] = {};
+        std::size_t prefix_len = 0;
+        uint32_t sample_every = 1;
+        int64_t interval = 0;                           /*!< ns per token, 0 - unlimited.*/
+        int64_t tolerance = 0;                          /*!< Burst in ns.*/
+        std::atomic<uint64_t> seen{0};
+        std::atomic<int64_t> tat{INT64_MIN / 2};        /*!< GCRA theoretical arrival time.*/
+        std::atomic<uint64_t> suppressed{0};            /*!< Dropped since last admitted message.*/
+    };
+
+    std::array<Rule, max_rules> rules;
+    std::atomic<std::size_t> count{0};
+    std::atomic<uint64_t> dropped_total{0};
+    std::mutex config_mtx;
+
+    static int64_t now() noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    Rule* match(uint32_t severity, const char* msg, std::size_t n) noexcept {
+        Rule* fallback = nullptr;
+        for (std::size_t r = 0; r < n; ++r) {
+            Rule& rule = rules[r];
+            if (rule.severity != severity)
+                continue;
+            if (rule.prefix_len == 0) {
+                if (!fallback)
+                    fallback = &rule;
+            } else if (std::strncmp(msg, rule.prefix, rule.prefix_len) == 0) {
+                return &rule;
+            }
+        }
+        return fallback;
+    }
+
+    static bool take(Rule& rule) noexcept {
+        if (rule.interval == 0)
+            return true;
+        const int64_t t = now();
+        int64_t tat = rule.tat.load(std::memory_order_relaxed);
+        for (;;) {
+            const int64_t base = std::max(tat, t);
+            if (base - t > rule.tolerance)
+                return false;
+            if (rule.tat.compare_exchange_weak(tat, base + rule.interval, std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+    static std::size_t summary(char* buf, std::size_t size, uint64_t n, const Rule& rule) {
+        const int len = rule.prefix_len
+            ? std::snprintf(buf, size, "Suppressed %llu similar messages (\"%s\").", static_cast<unsigned long long>(n), rule.prefix)
+            : std::snprintf(buf, size, "Suppressed %llu similar messages.", static_cast<unsigned long long>(n));
+        return len < 0 ? 0 : static_cast<std::size_t>(len);
+    }
+
+public:
+    LogLimiter() = default;
+    LogLimiter(const LogLimiter&) = delete;
+    LogLimiter& operator=(const LogLimiter&) = delete;
+
+    /*!
+    * Adds rule for messages of `severity` starting with `prefix` (empty - all of them).
+    * Safe to call while logging; rules can't be removed.
+    */
+    void limit(trt_types::Severity severity, const std::string& prefix, LogLimit l) {
+        if (l.sample_every == 0 || l.rate < 0.0 || l.burst < 1.0)
+            throw std::invalid_argument("Invalid log limit.");
+        if (prefix.size() > max_prefix)
+            throw std::invalid_argument("Log limit prefix too long.");
+        std::lock_guard<std::mutex> lock(config_mtx);
+        const std::size_t n = count.load(std::memory_order_relaxed);
+        if (n == max_rules)
+            throw std::length_error("Too many log limit rules.");
+        Rule& rule = rules[n];
+        rule.severity = static_cast<uint32_t>(cexpr_utils::to_underlying(severity));
+        std::memcpy(rule.prefix, prefix.data(), prefix.size());
+        rule.prefix_len = prefix.size();
+        rule.sample_every = l.sample_every;
+        rule.interval = l.rate > 0.0 ? std::max<int64_t>(1, static_cast<int64_t>(1e9 / l.rate)) : 0;
+        rule.tolerance = static_cast<int64_t>((l.burst - 1.0) * static_cast<double>(rule.interval));
+        count.store(n + 1, std::memory_order_release);
+    }
+
+    void limit(trt_types::Severity severity, LogLimit l) {
+        limit(severity, "", l);
+    }
+
+    /*!
+    * Whether message should be logged. When it should and earlier ones of the same rule were
+    * dropped, `emit_summary(const char*)` is called first.
+    */
+    template<typename F>
+    bool admit(uint32_t severity, const char* msg, F&& emit_summary) {
+        const std::size_t n = count.load(std::memory_order_acquire);
+        if (n == 0)
+            return true;
+        Rule* rule = match(severity, msg, n);
+        if (!rule)
+            return true;
+        const bool keep = (rule->sample_every == 1 ||
+                           rule->seen.fetch_add(1, std::memory_order_relaxed) % rule->sample_every == 0) && take(*rule);
+        if (!keep) {
+            rule->suppressed.fetch_add(1, std::memory_order_relaxed);
+            dropped_total.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (rule->suppressed.load(std::memory_order_relaxed) != 0) {
+            if (const uint64_t k = rule->suppressed.exchange(0, std::memory_order_relaxed)) {
+                char buf[128];
+                summary(buf, sizeof(buf), k, *rule);
+                emit_summary(static_cast<const char*>(buf));
+            }
+        }
+        return true;
+    }
+
+    /*!
+    * Reports pending suppressed counts as `emit(severity, summary)` - for logger shutdown.
+    */
+    template<typename F>
+    void drain(F&& emit) {
+        const std::size_t n = count.load(std::memory_order_acquire);
+        for (std::size_t r = 0; r < n; ++r) {
+            if (const uint64_t k = rules[r].suppressed.exchange(0, std::memory_order_relaxed)) {
+                char buf[128];
+                summary(buf, sizeof(buf), k, rules[r]);
+                emit(rules[r].severity, static_cast<const char*>(buf));
+            }
+        }
+    }
+
+    /*!
+    * Messages dropped since construction.
+    */
+    uint64_t dropped() const noexcept {
+        return dropped_total.load(std::memory_order_relaxed);
+    }
+};
+
+} // trttl namespace
+#endif // LOG_LIMITER_HPP
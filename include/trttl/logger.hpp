@@ -1,6 +1,8 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include "log_limiter.hpp"
+#include "rotating_log.hpp"
 #include "util/cexpr_utils.hpp"
 #include "util/trt_types.hpp"
 #include <NvInfer.h>
@@ -8,11 +10,18 @@
 #include <type_traits>
 #include <iostream>
 #include <iomanip>
+#include <streambuf>
 #include <fstream>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <ctime>
 #include <chrono>
 #include <tuple>
 #include <mutex>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
 
 namespace trttl {
 
@@ -52,6 +61,10 @@ public:
     }
 };
 
+/*!
+* Plain `trt.log` stream, truncated on open - kept for comparison, `RotatingFileLog<>` (appending to
+* `trt.log`) is the default file sink. Flushed by `Logger` after every line.
+*/
 class FileLog : public LogStream<FileLog>{
 private:
     std::ofstream fout;
@@ -75,6 +88,93 @@ public:
     }
 };
 
+/*!
+* High-throughput file sink - configurable path, appends (never truncates), rotates by size/age,
+* buffers in user space and flushes according to `config.flush`. Sinks of the same path share
+* one `LogFile` (and must agree on `config`), so several loggers (or levels) can write to it safely.
+* Each sink assembles a line in its own buffer and commits it whole.
+*
+* @tparam config - file, rotation and flush settings
+*/
+template<LogFileConfig config = LogFileConfig{}>
+class RotatingFileLog : public LogStream<RotatingFileLog<config>> {
+private:
+    /*!
+    * Collects current line in a put area (no virtual call per character) - formatting happens outside the file lock.
+    */
+    class LineBuf : public std::streambuf {
+    private:
+        std::vector<char> line = std::vector<char>(512);
+
+    public:
+        LineBuf() {
+            setp(line.data(), line.data() + line.size());
+        }
+
+        const char* data() const noexcept { return pbase(); }
+        std::size_t size() const noexcept { return static_cast<std::size_t>(pptr() - pbase()); }
+
+        void clear() noexcept {
+            setp(line.data(), line.data() + line.size());
+        }
+
+    protected:
+        int_type overflow(int_type c) override {
+            const std::size_t n = size();
+            line.resize(2 * line.size());
+            setp(line.data(), line.data() + line.size());
+            pbump(static_cast<int>(n));
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                sputc(traits_type::to_char_type(c));
+            return traits_type::not_eof(c);
+        }
+    };
+
+    std::shared_ptr<LogFile> file;
+    LineBuf buf;
+    std::ostream stream{&buf};
+
+    void handOff(uint32_t severity) {
+        if (buf.size()) {
+            file->append(buf.data(), buf.size(), severity);
+            buf.clear();
+        }
+    }
+
+public:
+    RotatingFileLog() : file(LogFile::open(config)) {}
+
+    RotatingFileLog(const RotatingFileLog&) = delete;
+    RotatingFileLog& operator=(const RotatingFileLog&) = delete;
+
+    ~RotatingFileLog() {
+        handOff(cexpr_utils::to_underlying(trt_types::Severity::kVERBOSE));
+    }
+
+    std::ostream& get_impl() {
+        return stream;
+    }
+
+    /*!
+    * Line finished - called by loggers.
+    */
+    void commit(uint32_t severity) {
+        handOff(severity);
+    }
+
+    /*!
+    * Writes out everything buffered, regardless of policy.
+    */
+    void flush() {
+        handOff(cexpr_utils::to_underlying(trt_types::Severity::kVERBOSE));
+        file->flush();
+    }
+
+    LogFile& logFile() noexcept {
+        return *file;
+    }
+};
+
 /*!
 * Special case for not writing.
 */
@@ -87,12 +187,97 @@ public:
     }
 };
 
+/*!
+* False only for `NoLog` - lets loggers elide disabled levels at compile time.
+*/
+template <typename T>
+inline constexpr bool log_enabled = !std::is_same_v<T, NoLog>;
+
 /*!
 * Concept for classes derived from LogStream.
 */
 template <typename T>
 concept DerivedFromLogStream = std::derived_from<T, LogStream<T>>;
 
+/*!
+* LogStream taking raw records instead of formatted text - loggers skip formatting for it.
+* `ticks` come from `LogClock`.
+*/
+template <typename T>
+concept RecordSink = DerivedFromLogStream<T> && requires(T& sink, uint32_t severity, uint64_t ticks,
+                                                         const std::source_location& location, const char* msg) {
+    sink.record(severity, ticks, location, msg);
+    sink.flush();
+};
+
+/*!
+* Text LogStream with its own flush policy - loggers call `commit(severity)` after each line
+* instead of flushing.
+*/
+template <typename T>
+concept CommitSink = DerivedFromLogStream<T> && requires(T& sink, uint32_t severity) {
+    sink.commit(severity);
+};
+
+/*!
+* Raw timestamps for `RecordSink`s - TSC on x86-64, steady clock ticks elsewhere.
+* Sinks store a calibration so readers can convert back to wall time.
+*/
+struct LogClock {
+    static uint64_t now() noexcept {
+#if defined(__x86_64__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+};
+
+/*!
+* Text layout shared by all loggers: prefix, timestamp, source_location and message.
+*/
+struct LogFormat {
+    static constexpr const char* lookup[5] = {                /*!< Static lookup-table for log level prefixes.*/
+        "[IE]", "[E]", "[W]", "[I]", "[V]"
+    };
+
+    /*!
+    * Formatted timestamp, cached per thread and reformatted only when the second changes.
+    */
+    static const char* timestamp(std::time_t time) {
+        thread_local std::time_t cached = -1;
+        thread_local char buf[32] = {};
+        if (time != cached) {
+            std::tm tm;
+            localtime_r(&time, &tm);
+            std::strftime(buf, sizeof(buf), "%FT%TZ", &tm);
+            cached = time;
+        }
+        return buf;
+    }
+
+    /*!
+    * Writes single record (without line terminator).
+    */
+    template<typename Str>
+    static void write(std::ostream& stream, std::size_t i, std::time_t time, const Str& file, uint32_t line,
+                      uint32_t column, const Str& function, const Str& msg) {
+        stream << lookup[i] << " " 
+               << timestamp(time)
+               << file << "("
+               << line << ":"
+               << column << ") `"
+               << function << "`: "
+               << msg;
+    }
+
+    static void write(std::ostream& stream, std::size_t i, std::time_t time, 
+                      const std::source_location& location, const char* msg) {
+        write<const char*>(stream, i, time, location.file_name(), location.line(), location.column(),
+                           location.function_name(), msg);
+    }
+};
+
 /*!
 * Thread-safe logger class.
 * Template interfaces:
@@ -101,6 +286,8 @@ concept DerivedFromLogStream = std::derived_from<T, LogStream<T>>;
 * NOTE: By default will assume all LogStreams as `NoLog` - won't produce output!
 *
 * LogStream objects are initialized only-once and stored for logger lifetime. 
+* Levels routed to `NoLog` compile to nothing (apart from throwing).
+* Plain streams are flushed after every line, `CommitSink`s follow their own flush policy.
 */
 template <DerivedFromLogStream LogStreamINTERNAL_ERROR = NoLog, 
           DerivedFromLogStream LogStreamERROR = NoLog, 
@@ -110,16 +297,23 @@ template <DerivedFromLogStream LogStreamINTERNAL_ERROR = NoLog,
           trt_types::Severity throwSeverity = trt_types::Severity::kERROR>
 class Logger : public nvinfer1::ILogger {
 private:
+    using Streams = std::tuple<LogStreamINTERNAL_ERROR, 
+                               LogStreamERROR, 
+                               LogStreamWARNING, 
+                               LogStreamINFO, 
+                               LogStreamVERBOSE>;
+
     static std::mutex mtx;                                    /*!< Mutex for thread safety.*/
-    static constexpr const char* lookup[5] = {                /*!< Static lookup-table for log level prefixes.*/
-        "[IE]", "[E]", "[W]", "[I]", "[V]"
+    static constexpr bool active[5] = {                       /*!< Levels that write or throw.*/
+        log_enabled<LogStreamINTERNAL_ERROR> || throwSeverity == trt_types::Severity::kINTERNAL_ERROR,
+        log_enabled<LogStreamERROR> || throwSeverity == trt_types::Severity::kERROR,
+        log_enabled<LogStreamWARNING> || throwSeverity == trt_types::Severity::kWARNING,
+        log_enabled<LogStreamINFO> || throwSeverity == trt_types::Severity::kINFO,
+        log_enabled<LogStreamVERBOSE> || throwSeverity == trt_types::Severity::kVERBOSE
     };
 
-    std::tuple<LogStreamINTERNAL_ERROR, 
-               LogStreamERROR, 
-               LogStreamWARNING, 
-               LogStreamINFO, 
-               LogStreamVERBOSE> log_streams;                 /*!< `LogStream` objects container.*/
+    Streams log_streams;                                      /*!< `LogStream` objects container.*/
+    LogLimiter limiter;                                       /*!< Sampling & rate limits, checked before locking.*/
 
     /*!
     * Log function.
@@ -129,20 +323,29 @@ private:
     void print_impl(const char* msg, const std::source_location location = 
              std::source_location::current()
     ) {
-        const auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
-        std::lock_guard<std::mutex> lock(mtx);
-        auto&& stream = std::get<i>(log_streams).get();
+        constexpr auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
+        if constexpr (RecordSink<std::tuple_element_t<i, Streams>>) {
+            const uint64_t ticks = LogClock::now();
+            std::lock_guard<std::mutex> lock(mtx);
+            std::get<i>(log_streams).record(static_cast<uint32_t>(i), ticks, location, msg);
+        } else if constexpr (log_enabled<std::tuple_element_t<i, Streams>>) {
+            const auto now = std::chrono::system_clock::now();
+            const std::time_t time = std::chrono::system_clock::to_time_t(now);
 
-        const auto now = std::chrono::system_clock::now();
-        const std::time_t time = std::chrono::system_clock::to_time_t(now);
+            std::lock_guard<std::mutex> lock(mtx);
+            auto&& stream = std::get<i>(log_streams).get();
+            LogFormat::write(stream, i, time, location, msg);
+            stream << '\n';
+            if constexpr (CommitSink<std::tuple_element_t<i, Streams>>)
+                std::get<i>(log_streams).commit(static_cast<uint32_t>(i));
+            else
+                stream.flush();
+        }
+    }
 
-        stream << lookup[i] << " " 
-               << std::put_time(std::localtime(&time), "%FT%TZ")
-               << location.file_name() << "("
-               << location.line() << ":"
-               << location.column() << ") `"
-               << location.function_name() << "`: "
-               << msg << std::endl;
+    template<std::size_t... Is>
+    void print_at(uint32_t i, const char* msg, std::index_sequence<Is...>) {
+        ((i == Is ? print_impl<static_cast<trt_types::Severity>(Is)>(msg) : void()), ...);
     }
 
     template<trt_types::Severity severity, bool B>
@@ -161,20 +364,47 @@ private:
     }  
 
 public:
+    Logger() = default;
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /*!
+    * Writes summaries of messages suppressed by `limits()`.
+    */
+    ~Logger() override {
+        limiter.drain([this](uint32_t i, const char* msg) { print_at(i, msg, std::make_index_sequence<5>{}); });
+    }
+
     /*!
     * Log function interface handles throwing.
+    * Throwing severity bypasses `limits()`.
     */
     template<trt_types::Severity severity>
     void print(const char* msg, const std::source_location location =
                std::source_location::current()
     ) {
+        constexpr auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
+        if constexpr (severity != throwSeverity && log_enabled<std::tuple_element_t<i, Streams>>) {
+            if (!limiter.admit(static_cast<uint32_t>(i), msg, [&](const char* summary) { print_impl<severity>(summary, location); }))
+                return;
+        }
         print_throw<severity, severity==throwSeverity>(msg, location);
     }
 
+    /*!
+    * Sampling & rate limiting rules, e.g. `limits().limit(kVERBOSE, {.sample_every = 100})`.
+    */
+    LogLimiter& limits() noexcept {
+        return limiter;
+    }
+
     /*! 
     * Just for TRT C++ API comaptibility.
     */ 
     void log(trt_types::Severity severity, const char* msg) noexcept override {
+        const auto i = cexpr_utils::to_underlying<trt_types::Severity>(severity);
+        if (i < 0 || i >= 5 || !active[i])
+            return;
         switch (severity) {
             case trt_types::Severity::kINTERNAL_ERROR:
                 print<trt_types::Severity::kINTERNAL_ERROR>(msg);
@@ -208,7 +438,7 @@ std::mutex Logger<LogStreamINTERNAL_ERROR, LogStreamERROR, LogStreamWARNING, Log
 /*!
 * Convinience naming for logger with default LogStreams setup.
 */
-using DefaultLogger = Logger<CerrLog, CerrLog, CoutLog, CoutLog, FileLog>;
+using DefaultLogger = Logger<CerrLog, CerrLog, CoutLog, CoutLog, RotatingFileLog<>>;
 
 } // trttl namespace
 #endif // LOGGER_HPP
\ No newline at end of file
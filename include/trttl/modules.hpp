@@ -2,39 +2,281 @@
 #define MODULE_HPP
 
 #include "util/cexpr_utils.hpp"
+#include "util/cpu_kernels.hpp"
+#include "util/simd_utils.hpp"
+#include "util/hash_utils.hpp"
 #include "util/trt_types.hpp"
+#include "weights.hpp"
+#include "tracing.hpp"
 #include <NvInfer.h>
+#include <algorithm>
+#include <stdexcept>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <unordered_map>
+#include <optional>
+#include <memory>
+#include <string_view>
+#include <string>
 #include <vector>
+#include <array>
 #include <tuple>
 
 namespace trttl {
 
+/*!
+* Batch size of a module - either fixed (implicit from `int32_t`) or dynamic `{min, opt, max}` range.
+* Dynamic ranges become `-1` batch dims and an optimization profile in `Network`.
+*/
+struct BatchSize {
+    int32_t min;
+    int32_t opt;
+    int32_t max;
+
+    constexpr BatchSize(int32_t b) : min(b), opt(b), max(b) {}
+    constexpr BatchSize(int32_t mn, int32_t op, int32_t mx) : min(mn), opt(op), max(mx) {}
+
+    constexpr bool valid() const { return 1 <= min && min <= opt && opt <= max; }
+    constexpr bool dynamic() const { return min != max; }
+
+    /*!
+    * True if every batch size of `other` is supported by this range.
+    */
+    constexpr bool covers(const BatchSize& other) const { return min <= other.min && other.max <= max; }
+
+    constexpr bool operator==(const BatchSize&) const = default;
+};
+
+/*!
+* Compile-time cost of a module's forward pass at its max batch size.
+*/
+struct Cost {
+    int64_t params = 0;                 /*!< Parameter count - what `bind()` loads, before any folding.*/
+    int64_t weight_bytes = 0;           /*!< Parameter storage (in parameter data type), as `params`.*/
+    int64_t macs = 0;                   /*!< Multiply-accumulates per batch.*/
+    int64_t flops = 0;                  /*!< Arithmetic ops per batch, MAC counts as 2.*/
+    int64_t activation_bytes = 0;       /*!< Peak live activations - input + output of the widest step.*/
+
+    /*!
+    * Cost of running `next` after this - work adds up, activation peak is the larger one.
+    */
+    constexpr Cost chain(const Cost& next) const {
+        return {params + next.params, weight_bytes + next.weight_bytes, macs + next.macs, flops + next.flops,
+                std::max(activation_bytes, next.activation_bytes)};
+    }
+};
+
+/*!
+* Names layers `[first, getNbLayers())` as `name/label` - `.k` suffixed when there is more than one.
+* Empty `name` (root module) leaves just the label.
+*/
+inline void nameLayers(trt_types::Network* network, int32_t first, const std::string& name, std::string_view label) {
+    const std::string base = name.empty() ? std::string(label) : name + "/" + std::string(label);
+    const int32_t last = network->getNbLayers();
+    for (int32_t i = first; i < last; ++i)
+        network->getLayer(i)->setName((last - first == 1 ? base : base + "." + std::to_string(i - first)).c_str());
+}
+
+/*!
+* Constant tensors added to one network, keyed by backing memory, dtype, count and shape.
+* The outermost `Module::addToNetwork` on a thread opens a table for its network, nested calls for
+* the same network reuse it - lookups stay O(1) however many layers the network already has.
+*/
+class SharedConstants {
+private:
+    struct Key {
+        const void* data;
+        int64_t count;
+        trt_types::DataType type;
+        trt_types::Dims dims;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key& k) const noexcept {
+            uint64_t h = hash_utils::combine(reinterpret_cast<uintptr_t>(k.data), static_cast<uint64_t>(k.count));
+            h = hash_utils::combine(h, static_cast<uint64_t>(k.type));
+            return static_cast<std::size_t>(hash_utils::combine(h, hash_utils::hash_dims(k.dims)));
+        }
+    };
+
+    trt_types::Network* network;
+    SharedConstants* outer;
+    std::unordered_map<Key, trt_types::Tensor*, KeyHash> tensors;
+
+    static SharedConstants*& current() noexcept {
+        thread_local SharedConstants* table = nullptr;
+        return table;
+    }
+
+public:
+    explicit SharedConstants(trt_types::Network* network) : network(network), outer(current()) {
+        if (!outer || outer->network != network)
+            current() = this;
+    }
+
+    SharedConstants(const SharedConstants&) = delete;
+    SharedConstants& operator=(const SharedConstants&) = delete;
+
+    ~SharedConstants() {
+        if (current() == this)
+            current() = outer;
+    }
+
+    /*!
+    * Constant tensor holding `w` with `dims` - reuses the one already added to `network` for the same
+    * memory and shape, so each blob interned by `WeightRegistry` becomes one constant (and one engine copy).
+    * Outside of `addToNetwork` every call adds a new constant.
+    */
+    static trt_types::Tensor* add(trt_types::Network* network, const trt_types::Dims& dims, const WeightBuffer& w) {
+        SharedConstants* table = current();
+        if (!table || table->network != network)
+            return network->addConstant(dims, trt_types::Weights{w.type(), w.data(), w.count()})->getOutput(0);
+        auto [it, added] = table->tensors.try_emplace(Key{w.data(), w.count(), w.type(), dims}, nullptr);
+        if (added)
+            it->second = network->addConstant(dims, trt_types::Weights{w.type(), w.data(), w.count()})->getOutput(0);
+        return it->second;
+    }
+};
+
+/*!
+* Constant tensor holding `w` with `dims`, shared per network (see `SharedConstants`).
+*/
+inline trt_types::Tensor* addSharedConstant(trt_types::Network* network, const trt_types::Dims& dims, const WeightBuffer& w) {
+    return SharedConstants::add(network, dims, w);
+}
+
 /*!
 * Analog to PyTorch's `nn.Module` - represents differentiable operations and their compositions.
 *
 * @tparam Derived - CRTP
-* @tparam bs - batch size
+* @tparam bs - batch size (fixed or `{min, opt, max}` range)
 * @tparam in - input shape
 * @tparam out - out shape
 * @tparam dt - data type
 */
-template<typename Derived, int32_t bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt>
+template<typename Derived, BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt>
+requires (bs.valid())
 class Module {
 public:
     Module() {
-        static_assert(std::is_member_function_pointer_v<decltype(&Derived::addToNetwork_impl)>, 
+        static_assert(requires (Derived& d, trt_types::Network* n, trt_types::Tensor* t) { d.addToNetwork_impl(n, t); } ||
+                      requires (Derived& d, trt_types::Network* n, trt_types::Tensor* t, const std::string& s) { d.addToNetwork_impl(n, t, s); },
                       "Derived must implement addToNetwork_impl().");
     }
 
     /*!
-    * Adds module to TRT network definition.
+    * Adds module to TRT network definition. Layers are named `name/Label` (`name/Label.k` if the module
+    * adds several), composite modules pass `name.i` on to their children (`bind()` naming), so profiles
+    * map back to model code. Composites implement `addToNetwork_impl(network, data, name)`.
+    */
+    trt_types::Tensor* addToNetwork(trt_types::Network* network, trt_types::Tensor* data, const std::string& name = ""){
+        TraceSpan span("define", label(), name);
+        SharedConstants constants(network);
+        if constexpr (requires (Derived& d) { d.addToNetwork_impl(network, data, name); }) {
+            return static_cast<Derived*>(this)->addToNetwork_impl(network, data, name);
+        } else {
+            const int32_t first = network->getNbLayers();
+            data = static_cast<Derived*>(this)->addToNetwork_impl(network, data);
+            nameLayers(network, first, name, label());
+            return data;
+        }
+    }
+
+    /*!
+    * Layer name label - unqualified type name.
+    */
+    static constexpr std::string_view label() {
+        return cexpr_utils::short_type_name<Derived>();
+    }
+
+    /*!
+    * Runs module on CPU for `batch_size` (max of range) samples:
+    * `x` holds `batch_size * dimVolume(in)` floats, `y` receives `batch_size * dimVolume(out)`.
+    * `scratch` must provide `workspace()` floats (64-byte aligned).
+    *
+    * @tparam V - `simd_utils` instruction set
+    */
+    template<typename V = simd_utils::Native>
+    void forward(const float* x, float* y, float* scratch){
+        static_assert(requires (Derived& d) { d.template forward_impl<V>(x, y, scratch); },
+                      "Derived must implement forward_impl() for CPU execution.");
+        static_cast<Derived*>(this)->template forward_impl<V>(x, y, scratch);
+    }
+
+    /*!
+    * Floats of scratch memory needed by `forward()`.
+    */
+    static constexpr std::size_t workspace() {
+        if constexpr (requires { Derived::workspace_impl(); })
+            return Derived::workspace_impl();
+        else
+            return 0;
+    }
+
+    /*!
+    * Compile-time cost (`Derived::cost_impl()`, zero work for modules without it).
+    * Activation peak defaults to input + output at max batch in `dt`.
+    */
+    static constexpr Cost cost() {
+        Cost c{};
+        if constexpr (requires { Derived::cost_impl(); })
+            c = Derived::cost_impl();
+        if (c.activation_bytes == 0)
+            c.activation_bytes = static_cast<int64_t>(bs.max) * (dimVolume(in) + dimVolume(out)) * static_cast<int64_t>(dataTypeSize(dt));
+        return c;
+    }
+
+    /*!
+    * Binds parameters to named tensors of a checkpoint (no-op for parameterless modules).
+    * Shapes/dtypes are validated against template params.
+    */
+    void bind(const Checkpoint& ckpt, const std::string& name){
+        TraceSpan span("weights", label(), name);
+        if constexpr (requires (Derived& d) { d.bind_impl(ckpt, name); })
+            static_cast<Derived*>(this)->bind_impl(ckpt, name);
+    }
+
+    /*!
+    * Replaces parameters with their `registry` counterparts (no-op for parameterless modules).
     */
-    trt_types::Tensor* addToNetwork(trt_types::Network* network, trt_types::Tensor* data){
-        return static_cast<Derived*>(this)->addToNetwork_impl(network, data);
+    void intern(WeightRegistry& registry) {
+        if constexpr (requires (Derived& d) { d.intern_impl(registry); })
+            static_cast<Derived*>(this)->intern_impl(registry);
     }
 
-    static constexpr int32_t batch_size = bs;
+    /*!
+    * Compile-time architecture fingerprint - batch size, shapes, dtype and layer-specific params
+    * (`Derived::fingerprint_impl()`, falls back to the type's spelling).
+    */
+    static constexpr uint64_t fingerprint() {
+        uint64_t h = hash_utils::combine(hash_utils::hash_dims(in), hash_utils::hash_dims(out));
+        h = hash_utils::combine(h, static_cast<uint64_t>(bs.min));
+        h = hash_utils::combine(h, static_cast<uint64_t>(bs.opt));
+        h = hash_utils::combine(h, static_cast<uint64_t>(bs.max));
+        h = hash_utils::combine(h, static_cast<uint64_t>(cexpr_utils::to_underlying(dt)));
+        if constexpr (requires { Derived::fingerprint_impl(); })
+            return hash_utils::combine(h, Derived::fingerprint_impl());
+        else
+            return hash_utils::combine(h, hash_utils::fnv1a(cexpr_utils::type_name<Derived>()));
+    }
+
+    /*!
+    * Hash of parameter contents (`seed` for parameterless modules).
+    */
+    uint64_t weightsHash(uint64_t seed = 0) const {
+        if constexpr (requires (const Derived& d) { d.weightsHash_impl(seed); })
+            return static_cast<const Derived*>(this)->weightsHash_impl(seed);
+        else
+            return seed;
+    }
+
+    static constexpr BatchSize batch_range = bs;
+    static constexpr int32_t batch_size = bs.max;             /*!< Largest supported batch - sizes host buffers.*/
     static constexpr trt_types::Dims in_shape = in;
     static constexpr trt_types::Dims out_shape = out;
     static constexpr trt_types::DataType data_type = dt;
@@ -44,100 +286,562 @@ public:
 * Concept for classes derived from Module.
 */
 template<typename T>
-concept DerivedFromModule = std::derived_from<T, Module<T, T::batch_size, T::in_shape, T::out_shape, T::data_type>>;
+concept DerivedFromModule = std::derived_from<T, Module<T, T::batch_range, T::in_shape, T::out_shape, T::data_type>>;
 
 /*!
-* Checks whether data types/batch sizes in a sequence of modules match. Needed for Sequential.
+* Checks whether data types/shapes/batch ranges in a sequence of modules match. Needed for Sequential.
+* Adjacent batch ranges must overlap; `Sequential` additionally requires each to cover its own range.
 */
-template<typename... Ms>
-struct check_seq;
+template<DerivedFromModule... Ms, std::size_t... Is>
+constexpr bool linked(std::index_sequence<Is...>) {
+    [[maybe_unused]] constexpr BatchSize ranges[] = {Ms::batch_range...};
+    [[maybe_unused]] constexpr trt_types::Dims ins[] = {Ms::in_shape...}, outs[] = {Ms::out_shape...};
+    [[maybe_unused]] constexpr trt_types::DataType types[] = {Ms::data_type...};
+    return ((ranges[Is].min <= ranges[Is + 1].max && ranges[Is + 1].min <= ranges[Is].max &&
+             outs[Is] == ins[Is + 1] && types[Is] == types[Is + 1]) && ...);
+}
 
-template<DerivedFromModule M>
-struct check_seq<M> : std::true_type {};
+template<DerivedFromModule M, DerivedFromModule... Ms>
+struct check_seq : std::bool_constant<linked<M, Ms...>(std::index_sequence_for<Ms...>{})> {};
 
-template<DerivedFromModule M1, DerivedFromModule M2, DerivedFromModule... Ms>
-struct check_seq<M1, M2, Ms...>
-    : std::conditional_t<
-        (M1::batch_size == M2::batch_size)&&(M1::out_shape == M2::in_shape)&&(M1::data_type == M2::data_type), 
-        check_seq<M2, Ms...>, 
-        std::false_type> 
-    {};
+namespace rewrite {
+    template<BatchSize bs, DerivedFromModule M, DerivedFromModule... Ms>
+    auto lower(const M& m, const Ms&... ms);
+
+    template<DerivedFromModule M, DerivedFromModule... Ms>
+    std::vector<std::string> names(const std::string& name, const M& m, const Ms&... ms);
+} // rewrite namespace
 
 /*!
 * Sequential module - allows to compose operations/layers one after another.
+* Children are lowered (TRT and CPU) through the `rewrite` pass - adjacent layers are folded/fused
+* at compile time, while binding, fingerprint and weights hash still follow the listed modules.
 * 
 * @tparam M - at least one module inside
 * @tparam Ms - possibly more
 */
-template<int32_t bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, DerivedFromModule M, DerivedFromModule... Ms>
-requires (M::in_shape == in && M::data_type == dt && M::batch_size == bs && cexpr_utils::last<Ms...>::out_shape == out && check_seq<M, Ms...>::value)
+template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, DerivedFromModule M, DerivedFromModule... Ms>
+requires (M::in_shape == in && M::data_type == dt && M::batch_range.covers(bs) && (Ms::batch_range.covers(bs) && ...) && 
+          cexpr_utils::last<M, Ms...>::out_shape == out && check_seq<M, Ms...>::value)
 class Sequential : public Module<Sequential<bs, in, out, dt, M, Ms...>, bs, in, out, dt> {
+public:
+    using Lowered = decltype(rewrite::lower<bs>(std::declval<const M&>(), std::declval<const Ms&>()...));
+
 private:
     std::tuple<M, Ms...> modules;
+    std::optional<Lowered> lowered_modules;                 /*!< Built on first lowering, reset by `bind()`.*/
 
 public:
     Sequential() : modules() {}
-    Sequential(M m, Ms... ms) : modules(m, ms...) {}
+    Sequential(M m, Ms... ms) : modules(std::move(m), std::move(ms)...) {}
 
-    template<DerivedFromModule... Modules>
-    static constexpr trt_types::Tensor* addToNetwork_fold(trt_types::Network* network, trt_types::Tensor* data, Modules... modules) {
-        ((data = modules.addToNetwork_impl(network, data)), ...);
+    /*!
+    * Listed modules, as bound and hashed.
+    */
+    const std::tuple<M, Ms...>& children() const {
+        return modules;
+    }
+
+    /*!
+    * Children after the rewrite pass - unchanged parameters are shared with listed modules.
+    */
+    Lowered& lowered() {
+        if (!lowered_modules) {
+            TraceSpan span("weights", "Sequential::lowered");
+            lowered_modules.emplace(std::apply([](const auto&... ms) { return rewrite::lower<bs>(ms...); }, modules));
+        }
+        return *lowered_modules;
+    }
+
+    /*!
+    * Lowered children are named after the listed ones they came from (`name.i`, `name.i+name.j` if merged).
+    */
+    trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data, const std::string& name) {
+        const auto names = std::apply([&](const auto&... ms) { return rewrite::names(name, ms...); }, modules);
+        auto& ls = lowered();
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ((data = std::get<Is>(ls).addToNetwork(network, data, names[Is])), ...);
+        }(std::make_index_sequence<std::tuple_size_v<Lowered>>{});
         return data;
     }
 
-    trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data) {
-        return std::apply(addToNetwork_fold<M, Ms...>, std::tuple_cat(std::make_tuple(network, data), modules));
+    static constexpr uint64_t fingerprint_impl() {
+        uint64_t h = hash_utils::fnv1a("Sequential");
+        ((h = hash_utils::combine(h, M::fingerprint())), ..., (h = hash_utils::combine(h, Ms::fingerprint())));
+        return h;
+    }
+
+    /*!
+    * Size (floats, padded to 64 bytes) of each of the two ping-pong buffers between lowered children.
+    */
+    static constexpr std::size_t buffer_size() {
+        return []<typename... Ls>(std::type_identity<std::tuple<Ls...>>) {
+            std::size_t m = 0;
+            ((m = std::max<std::size_t>(m, static_cast<std::size_t>(bs.max) * dimVolume(Ls::out_shape))), ...);
+            return (m + 15) / 16 * 16;
+        }(std::type_identity<Lowered>{});
+    }
+
+    /*!
+    * Parameters of the listed children (what `bind()` loads), work and activation peak of the lowered
+    * ones (what actually runs, so folded layers are counted once) - budgets don't depend on the rewrite pass.
+    */
+    static constexpr Cost cost_impl() {
+        Cost c = []<typename... Ls>(std::type_identity<std::tuple<Ls...>>) {
+            Cost r{};
+            ((r = r.chain(Ls::cost())), ...);
+            return r;
+        }(std::type_identity<Lowered>{});
+        c.params = M::cost().params + (Ms::cost().params + ... + 0);
+        c.weight_bytes = M::cost().weight_bytes + (Ms::cost().weight_bytes + ... + 0);
+        return c;
+    }
+
+    static constexpr std::size_t workspace_impl() {
+        return 2 * buffer_size() + []<typename... Ls>(std::type_identity<std::tuple<Ls...>>) {
+            return std::max({std::size_t{0}, Ls::workspace()...});
+        }(std::type_identity<Lowered>{});
+    }
+
+    template<typename V>
+    void forward_impl(const float* x, float* y, float* scratch) {
+        constexpr std::size_t n = std::tuple_size_v<Lowered>;
+        float* bufs[2] = {scratch, scratch + buffer_size()};
+        float* child = scratch + 2 * buffer_size();
+        auto& ls = lowered();
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            static_assert(((std::tuple_element_t<Is, Lowered>::batch_size == bs.max) && ...),
+                          "CPU execution needs children with the same max batch size.");
+            (std::get<Is>(ls).template forward<V>(
+                Is == 0 ? x : bufs[(Is + 1) % 2],
+                Is == n - 1 ? y : bufs[Is % 2],
+                child), ...);
+        }(std::make_index_sequence<n>{});
+    }
+
+    uint64_t weightsHash_impl(uint64_t seed) const {
+        return std::apply([&](const auto&... ms) {
+            ((seed = ms.weightsHash(seed)), ...);
+            return seed;
+        }, modules);
+    }
+
+    /*!
+    * Binds i-th module to `name.i` (PyTorch `nn.Sequential` naming).
+    */
+    void bind_impl(const Checkpoint& ckpt, const std::string& name) {
+        const std::string prefix = name.empty() ? "" : name + ".";
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (std::get<Is>(modules).bind(ckpt, prefix + std::to_string(Is)), ...);
+        }(std::index_sequence_for<M, Ms...>{});
+        lowered_modules.reset();
+    }
+
+    /*!
+    * Interns listed modules, then lowered ones - merged parameters are deduplicated as well.
+    */
+    void intern_impl(WeightRegistry& registry) {
+        std::apply([&](auto&... ms) { (ms.intern(registry), ...); }, modules);
+        lowered_modules.reset();
+        std::apply([&](auto&... ls) { (ls.intern(registry), ...); }, lowered());
+    }
+};
+
+/*!
+* Shape of `ds` concatenated along `axis` - ranks and all other dims must match, otherwise `nbDims == -1`.
+*/
+template<std::size_t n>
+constexpr trt_types::Dims concatDims(int32_t axis, const std::array<trt_types::Dims, n>& ds) {
+    constexpr trt_types::Dims invalid{-1, {}};
+    trt_types::Dims r = ds[0];
+    if (axis < 0 || axis >= r.nbDims)
+        return invalid;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (ds[i].nbDims != r.nbDims)
+            return invalid;
+        for (int32_t j = 0; j < r.nbDims; ++j) {
+            if (j == axis)
+                r.d[j] += ds[i].d[j];
+            else if (ds[i].d[j] != r.d[j])
+                return invalid;
+        }
+    }
+    return r;
+}
+
+/*!
+* Checks branches of `Parallel`/`Split` - data types match, batch ranges cover `bs`
+* and outputs concatenate to `out` along `axis`.
+*/
+template<BatchSize bs, trt_types::Dims out, trt_types::DataType dt, int32_t axis, DerivedFromModule... Bs>
+struct check_branches
+    : std::bool_constant<((Bs::data_type == dt && Bs::batch_range.covers(bs)) && ...) &&
+                         concatDims(axis, std::array{Bs::out_shape...}) == out>
+    {};
+
+/*!
+* Common part of `Parallel` and `Split` - runs branches on the whole input (or its slices along `axis`
+* when `split`) and concatenates their outputs along `axis`. Axis counts sample dims, batch excluded.
+* TRT gets all branches in one network and may run them concurrently.
+*/
+template<typename Derived, bool split, BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, int32_t axis,
+         DerivedFromModule... Bs>
+class BranchModule : public Module<Derived, bs, in, out, dt> {
+private:
+    static constexpr std::size_t n = sizeof...(Bs);
+    using Branches = std::tuple<Bs...>;
+
+    std::tuple<Bs...> branches;
+
+    /*!
+    * Start of every branch along `axis` within concatenated shape.
+    */
+    static constexpr std::array<int32_t, n> offsets(const std::array<trt_types::Dims, n>& ds) {
+        std::array<int32_t, n> o{};
+        for (std::size_t i = 1; i < n; ++i)
+            o[i] = o[i - 1] + ds[i - 1].d[axis];
+        return o;
+    }
+
+    static constexpr std::array<int32_t, n> in_offsets = offsets({Bs::in_shape...});
+    static constexpr std::array<int32_t, n> out_offsets = offsets({Bs::out_shape...});
+
+    /*!
+    * Shape tensor constants for dynamic batch slices: `size = shape(x) * keep + fixed`.
+    */
+    template<typename B>
+    struct SliceSize {
+        static constexpr std::array<int32_t, in.nbDims + 1> keep = [] {
+            std::array<int32_t, in.nbDims + 1> k{};
+            k[0] = 1;
+            return k;
+        }();
+        static constexpr std::array<int32_t, in.nbDims + 1> fixed = [] {
+            std::array<int32_t, in.nbDims + 1> f{};
+            for (int32_t i = 0; i < in.nbDims; ++i)
+                f[i + 1] = B::in_shape.d[i];
+            return f;
+        }();
+    };
+
+    /*!
+    * Copies `outer` rows of `len` floats between tensors with row strides `src_stride`/`dst_stride`.
+    */
+    static void copyRows(const float* src, float* dst, std::size_t outer, std::size_t len, std::size_t src_stride, std::size_t dst_stride) {
+        for (std::size_t o = 0; o < outer; ++o)
+            std::copy(src + o * src_stride, src + o * src_stride + len, dst + o * dst_stride);
+    }
+
+    /*!
+    * Rows before `axis` (incl. batch) and floats per row from `axis` on for `part` inside `whole`.
+    */
+    static constexpr std::size_t outerRows(const trt_types::Dims& whole) {
+        std::size_t r = static_cast<std::size_t>(bs.max);
+        for (int32_t i = 0; i < axis; ++i)
+            r *= static_cast<std::size_t>(whole.d[i]);
+        return r;
+    }
+
+    static constexpr std::size_t rowLen(const trt_types::Dims& d, int32_t from = axis) {
+        std::size_t r = 1;
+        for (int32_t i = from; i < d.nbDims; ++i)
+            r *= static_cast<std::size_t>(d.d[i]);
+        return r;
+    }
+
+    static constexpr std::size_t padded(std::size_t floats) {
+        return (floats + 15) / 16 * 16;
+    }
+
+    static constexpr std::size_t in_area = split ? padded(std::max({static_cast<std::size_t>(bs.max) * dimVolume(Bs::in_shape)...})) : 0;
+    static constexpr std::size_t out_area = padded(std::max({static_cast<std::size_t>(bs.max) * dimVolume(Bs::out_shape)...}));
+
+    template<std::size_t I>
+    static trt_types::Tensor* slice(trt_types::Network* network, trt_types::Tensor* data) {
+        using B = std::tuple_element_t<I, Branches>;
+        const trt_types::Dims dims = data->getDimensions();
+        const int32_t lead = dims.nbDims - in.nbDims;
+        trt_types::Dims start{dims.nbDims, {}}, size = dims, stride{dims.nbDims, {}};
+        bool dynamic = false;
+        for (int32_t i = 0; i < dims.nbDims; ++i) {
+            stride.d[i] = 1;
+            dynamic = dynamic || dims.d[i] < 0;
+        }
+        start.d[lead + axis] = in_offsets[I];
+        for (int32_t i = 0; i < in.nbDims; ++i)
+            size.d[lead + i] = B::in_shape.d[i];
+
+        auto* layer = network->addSlice(*data, start, size, stride);
+        if (dynamic) {
+            // -1 batch (leading dim added by `Network`) - size comes from a shape tensor
+            const trt_types::Dims vec{1, {in.nbDims + 1}};
+            auto* shape = network->addShape(*data)->getOutput(0);
+            auto* keep = network->addConstant(vec, {trt_types::DataType::kINT32, SliceSize<B>::keep.data(), in.nbDims + 1})->getOutput(0);
+            auto* fixed = network->addConstant(vec, {trt_types::DataType::kINT32, SliceSize<B>::fixed.data(), in.nbDims + 1})->getOutput(0);
+            auto* kept = network->addElementWise(*shape, *keep, trt_types::ElementWiseOperation::kPROD)->getOutput(0);
+            layer->setInput(2, *network->addElementWise(*kept, *fixed, trt_types::ElementWiseOperation::kSUM)->getOutput(0));
+        }
+        return layer->getOutput(0);
+    }
+
+public:
+    BranchModule() = default;
+    BranchModule(Bs... bs_) : branches(std::move(bs_)...) {}
+
+    std::tuple<Bs...>& children() noexcept { return branches; }
+
+    /*!
+    * Branch `i` is named `name.i`, its input slice `name.i/Slice`.
+    */
+    trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data, const std::string& name) {
+        const std::string prefix = name.empty() ? "" : name + ".";
+        std::array<trt_types::Tensor*, n> outs{};
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ([&] {
+                trt_types::Tensor* x = data;
+                if constexpr (split) {
+                    const int32_t first = network->getNbLayers();
+                    x = slice<Is>(network, data);
+                    nameLayers(network, first, prefix + std::to_string(Is), "Slice");
+                }
+                outs[Is] = std::get<Is>(branches).addToNetwork(network, x, prefix + std::to_string(Is));
+            }(), ...);
+        }(std::make_index_sequence<n>{});
+        if constexpr (n == 1)
+            return outs[0];
+
+        const int32_t first = network->getNbLayers();
+        auto* concat = network->addConcatenation(outs.data(), static_cast<int32_t>(n));
+        concat->setAxis(data->getDimensions().nbDims - in.nbDims + axis);
+        nameLayers(network, first, name, "Concat");
+        return concat->getOutput(0);
+    }
+
+    static constexpr uint64_t fingerprint_impl() {
+        uint64_t h = hash_utils::combine(hash_utils::fnv1a(split ? "Split" : "Parallel"), static_cast<uint64_t>(axis));
+        ((h = hash_utils::combine(h, Bs::fingerprint())), ...);
+        return h;
+    }
+
+    /*!
+    * Work of all branches; input and concatenated output stay live while the widest branch runs.
+    */
+    static constexpr Cost cost_impl() {
+        Cost c{};
+        ((c = c.chain(Bs::cost())), ...);
+        c.activation_bytes += static_cast<int64_t>(bs.max) * (dimVolume(in) + dimVolume(out)) * static_cast<int64_t>(dataTypeSize(dt));
+        return c;
     }
+
+    static constexpr std::size_t workspace_impl() {
+        return in_area + out_area + std::max({std::size_t{0}, Bs::workspace()...});
+    }
+
+    template<typename V>
+    void forward_impl(const float* x, float* y, float* scratch) {
+        static_assert(((Bs::batch_size == bs.max) && ...), "CPU execution needs branches with the same max batch size.");
+        float* in_buf = scratch;
+        float* out_buf = scratch + in_area;
+        float* child = out_buf + out_area;
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ([&] {
+                using B = std::tuple_element_t<Is, Branches>;
+                const float* bx = x;
+                if constexpr (split) {
+                    copyRows(x + in_offsets[Is] * rowLen(in, axis + 1), in_buf, outerRows(in), rowLen(B::in_shape),
+                             rowLen(in), rowLen(B::in_shape));
+                    bx = in_buf;
+                }
+                std::get<Is>(branches).template forward<V>(bx, out_buf, child);
+                copyRows(out_buf, y + out_offsets[Is] * rowLen(out, axis + 1), outerRows(out), rowLen(B::out_shape),
+                         rowLen(B::out_shape), rowLen(out));
+            }(), ...);
+        }(std::make_index_sequence<n>{});
+    }
+
+    uint64_t weightsHash_impl(uint64_t seed) const {
+        return std::apply([&](const auto&... bs_) {
+            ((seed = bs_.weightsHash(seed)), ...);
+            return seed;
+        }, branches);
+    }
+
+    /*!
+    * Binds i-th branch to `name.i`.
+    */
+    void bind_impl(const Checkpoint& ckpt, const std::string& name) {
+        const std::string prefix = name.empty() ? "" : name + ".";
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (std::get<Is>(branches).bind(ckpt, prefix + std::to_string(Is)), ...);
+        }(std::make_index_sequence<n>{});
+    }
+
+    void intern_impl(WeightRegistry& registry) {
+        std::apply([&](auto&... bs_) { (bs_.intern(registry), ...); }, branches);
+    }
+};
+
+/*!
+* Parallel branches - every branch gets the whole input, outputs are concatenated along `axis`
+* (multi-head models as one engine, one input copy and one output copy).
+*
+* @tparam axis - concat axis of sample shape (batch excluded)
+*/
+template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, int32_t axis, DerivedFromModule M, DerivedFromModule... Ms>
+requires (M::in_shape == in && ((Ms::in_shape == in) && ...) && check_branches<bs, out, dt, axis, M, Ms...>::value)
+class Parallel : public BranchModule<Parallel<bs, in, out, dt, axis, M, Ms...>, false, bs, in, out, dt, axis, M, Ms...> {
+public:
+    using BranchModule<Parallel, false, bs, in, out, dt, axis, M, Ms...>::BranchModule;
+};
+
+/*!
+* Split input along `axis` into consecutive slices sized by branch inputs, run each branch
+* on its slice and concatenate outputs along the same axis.
+*
+* @tparam axis - split/concat axis of sample shape (batch excluded)
+*/
+template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, int32_t axis, DerivedFromModule M, DerivedFromModule... Ms>
+requires (concatDims(axis, std::array{M::in_shape, Ms::in_shape...}) == in && check_branches<bs, out, dt, axis, M, Ms...>::value)
+class Split : public BranchModule<Split<bs, in, out, dt, axis, M, Ms...>, true, bs, in, out, dt, axis, M, Ms...> {
+public:
+    using BranchModule<Split, true, bs, in, out, dt, axis, M, Ms...>::BranchModule;
 };
 
 /*!
 * FullyConnected LinearLayer - pretty self-explanatory.
+* Weights are laid out `[dimVolume(out), dimVolume(in)]` row-major (PyTorch `nn.Linear`), biases `[dimVolume(out)]`.
+* Parameters live in refcounted `WeightBuffer`s - copying the layer never copies weights.
+* When bound to a checkpoint (`name.weight`, `name.bias`) mapped memory is used directly.
+* kHALF layers keep fp16 parameters (converted once if given fp32), kINT8 layers keep fp32 ones -
+* TRT's implicit quantization derives per-channel weight scales itself, the calibrator covers activations.
 */
-template<int32_t bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt>
+template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt>
 requires (in.nbDims == 2 && out.nbDims == 2)
 class LinearLayer : public Module<LinearLayer<bs, in, out, dt>, bs, in, out, dt> {
+public:
+    static constexpr trt_types::DataType param_type =
+        dt == trt_types::DataType::kHALF ? trt_types::DataType::kHALF : trt_types::DataType::kFLOAT;
+
 private:
-    std::vector<float> w_data;
-    std::vector<float> b_data;
+    WeightBuffer w_data;
+    WeightBuffer b_data;
+
+    void check() const {
+        if (w_data.count() != static_cast<int64_t>(dimVolume(in))*dimVolume(out) || b_data.count() != dimVolume(out))
+            throw std::runtime_error("LinearLayer parameter count does not match its shape.");
+    }
+
+    /*!
+    * Accepts fp32 or fp16 checkpoint tensor, converting only if it differs from `param_type`.
+    */
+    static WeightBuffer load(const Checkpoint& ckpt, const std::string& name, std::vector<int64_t> shape) {
+        const auto stored = ckpt.get(name).type;
+        const bool convertible = stored == trt_types::DataType::kFLOAT || stored == trt_types::DataType::kHALF;
+        return WeightBuffer::mapped(ckpt.get(name, convertible ? *stored : param_type, std::move(shape))).converted(param_type);
+    }
 
 public:
-    LinearLayer() {
-        w_data = std::vector<float>(dimVolume(in)*dimVolume(out), 0.1f);
-        b_data = std::vector<float>(dimVolume(out), 0.1f);
+    LinearLayer()
+        : w_data(WeightBuffer::filled(static_cast<int64_t>(dimVolume(in))*dimVolume(out), 0.1f).converted(param_type)),
+          b_data(WeightBuffer::filled(dimVolume(out), 0.1f).converted(param_type)) {}
+
+    /*!
+    * Copies parameters once - prefer rvalue/`WeightBuffer` overloads for large models.
+    */
+    LinearLayer(const std::vector<float> &weights, const std::vector<float> &biases)
+        : w_data(param_type == trt_types::DataType::kFLOAT ? WeightBuffer::copy(weights) : WeightBuffer::view(weights).converted(param_type)),
+          b_data(param_type == trt_types::DataType::kFLOAT ? WeightBuffer::copy(biases) : WeightBuffer::view(biases).converted(param_type)) {
+        check();
     }
 
-    LinearLayer(std::vector<float> &weights, std::vector<float> &biases) {
-        w_data = weights;
-        b_data = biases;
+    LinearLayer(std::vector<float> &&weights, std::vector<float> &&biases)
+        : w_data(param_type == trt_types::DataType::kFLOAT ? WeightBuffer::adopt(std::move(weights)) : WeightBuffer::view(weights).converted(param_type)),
+          b_data(param_type == trt_types::DataType::kFLOAT ? WeightBuffer::adopt(std::move(biases)) : WeightBuffer::view(biases).converted(param_type)) {
+        check();
     }
+
+    LinearLayer(WeightBuffer weights, WeightBuffer biases)
+        : w_data(weights.converted(param_type)), b_data(biases.converted(param_type)) {
+        check();
+    }
+
+    const WeightBuffer& weights() const noexcept { return w_data; }
+    const WeightBuffer& biases() const noexcept { return b_data; }
     
+    /*!
+    * Constant tensor dims - leading 1 broadcasts over any (dynamic) batch size.
+    */
     static auto calcParamDims() {
-        return std::make_tuple(trt_types::Dims3{bs, dimVolume(in), dimVolume(out)}, trt_types::Dims3{bs, 1, dimVolume(out)});
+        return std::make_tuple(trt_types::Dims3{1, dimVolume(out), dimVolume(in)}, trt_types::Dims3{1, 1, dimVolume(out)});
     }
 
     trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data) {
         auto paramDims = calcParamDims();
 
-        auto weights = trt_types::Weights{dt, w_data.data(), static_cast<int64_t>(w_data.size())};
-        auto w_tensor = network->addConstant(std::get<0>(paramDims), weights)->getOutput(0);
-        auto matmul = network->addMatrixMultiply(*data, trt_types::MatrixOperation::kNONE, *w_tensor, trt_types::MatrixOperation::kNONE);
+        auto w_tensor = addSharedConstant(network, std::get<0>(paramDims), w_data);
+        auto matmul = network->addMatrixMultiply(*data, trt_types::MatrixOperation::kNONE, *w_tensor, trt_types::MatrixOperation::kTRANSPOSE);
 
-        auto biases = trt_types::Weights{dt, b_data.data(), static_cast<int64_t>(b_data.size())};
-        auto b_tensor = network->addConstant(std::get<1>(paramDims), biases)->getOutput(0);
+        auto b_tensor = addSharedConstant(network, std::get<1>(paramDims), b_data);
         auto add = network->addElementWise(*matmul->getOutput(0), *b_tensor, trt_types::ElementWiseOperation::kSUM);
 
         return add->getOutput(0);
     }
+
+    static constexpr uint64_t fingerprint_impl() {
+        return hash_utils::fnv1a("LinearLayer");
+    }
+
+    static constexpr Cost cost_impl() {
+        constexpr int64_t B = bs.max, K = dimVolume(in), N = dimVolume(out);
+        constexpr int64_t params = K * N + N;
+        return {params, params * static_cast<int64_t>(dataTypeSize(param_type)), B * K * N, 2 * B * K * N + B * N};
+    }
+
+    template<typename V>
+    void forward_impl(const float* x, float* y, float*) {
+        static_assert(dt == trt_types::DataType::kFLOAT, "CPU execution supports kFLOAT only.");
+        cpu_kernels::linear<V, bs.max, dimVolume(in), dimVolume(out)>(
+            x, static_cast<const float*>(w_data.data()), static_cast<const float*>(b_data.data()), y);
+    }
+
+    uint64_t weightsHash_impl(uint64_t seed) const {
+        seed = hash_utils::hash_blob(w_data.data(), w_data.bytes(), seed);
+        return hash_utils::hash_blob(b_data.data(), b_data.bytes(), seed);
+    }
+
+    void bind_impl(const Checkpoint& ckpt, const std::string& name) {
+        w_data = load(ckpt, name + ".weight", {dimVolume(out), dimVolume(in)});
+        b_data = load(ckpt, name + ".bias", {dimVolume(out)});
+    }
+
+    void intern_impl(WeightRegistry& registry) {
+        w_data = registry.intern(w_data);
+        b_data = registry.intern(b_data);
+    }
 };
 
 /*!
 * Activation Layer.
 */
-template<int32_t bs, trt_types::Dims size, trt_types::DataType dt, trt_types::ActivationType at>
+template<BatchSize bs, trt_types::Dims size, trt_types::DataType dt, trt_types::ActivationType at>
 class ActivationLayer : public Module<ActivationLayer<bs, size, dt, at>, bs, size, size, dt> {
 public:
     static constexpr trt_types::ActivationType activation_type = at;
 
+    static constexpr uint64_t fingerprint_impl() {
+        return hash_utils::combine(hash_utils::fnv1a("ActivationLayer"), static_cast<uint64_t>(cexpr_utils::to_underlying(at)));
+    }
+
+    static constexpr Cost cost_impl() {
+        return {0, 0, 0, static_cast<int64_t>(bs.max) * dimVolume(size)};
+    }
+
+    template<typename V>
+    void forward_impl(const float* x, float* y, float*) {
+        static_assert(dt == trt_types::DataType::kFLOAT, "CPU execution supports kFLOAT only.");
+        cpu_kernels::activation<V, at>(x, y, static_cast<std::size_t>(bs.max) * dimVolume(size));
+    }
+
     trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data) {
         auto activation = network->addActivation(*data, activation_type);
         return activation->getOutput(0);
@@ -147,14 +851,514 @@ public:
 /*!
 * Softmax Layer.
 */
-template<int32_t bs, trt_types::Dims size, trt_types::DataType dt>
+template<BatchSize bs, trt_types::Dims size, trt_types::DataType dt>
 class SoftmaxLayer : public Module<SoftmaxLayer<bs, size, dt>, bs, size, size, dt> {
 public:
+    static constexpr uint64_t fingerprint_impl() {
+        return hash_utils::fnv1a("SoftmaxLayer");
+    }
+
+    /*!
+    * Max, subtract, exp, sum and divide - one op each per element.
+    */
+    static constexpr Cost cost_impl() {
+        return {0, 0, 0, 5 * static_cast<int64_t>(bs.max) * dimVolume(size)};
+    }
+
+    /*!
+    * Softmax over the last axis (rows are all leading axes incl. batch).
+    */
+    template<typename V>
+    void forward_impl(const float* x, float* y, float*) {
+        static_assert(dt == trt_types::DataType::kFLOAT, "CPU execution supports kFLOAT only.");
+        constexpr std::size_t cols = size.d[size.nbDims - 1];
+        cpu_kernels::softmax<V>(x, y, static_cast<std::size_t>(bs.max) * dimVolume(size) / cols, cols);
+    }
+
     trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data) {
         auto sm = network->addSoftMax(*data);
+        sm->setAxes(1U << (data->getDimensions().nbDims - 1));
         return sm->getOutput(0);
     }
 };
 
+/*!
+* Identity Layer - passes data through, dropped by `Sequential` lowering.
+*/
+template<BatchSize bs, trt_types::Dims size, trt_types::DataType dt>
+class IdentityLayer : public Module<IdentityLayer<bs, size, dt>, bs, size, size, dt> {
+public:
+    static constexpr uint64_t fingerprint_impl() {
+        return hash_utils::fnv1a("IdentityLayer");
+    }
+
+    template<typename V>
+    void forward_impl(const float* x, float* y, float*) {
+        if (x != y)
+            std::copy(x, x + static_cast<std::size_t>(bs.max) * dimVolume(size), y);
+    }
+
+    trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data) {
+        return network->addIdentity(*data)->getOutput(0);
+    }
+};
+
+/*!
+* LinearLayer with activation applied in the same pass - produced by `Sequential` lowering.
+* On CPU the activation runs on accumulators before they are stored; TRT gets MatMul+bias+Activation
+* as one chain it fuses into a single kernel.
+*/
+template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, trt_types::ActivationType at>
+class FusedLinearLayer : public Module<FusedLinearLayer<bs, in, out, dt, at>, bs, in, out, dt> {
+private:
+    LinearLayer<bs, in, out, dt> linear;
+
+public:
+    static constexpr trt_types::ActivationType activation_type = at;
+
+    FusedLinearLayer() = default;
+    FusedLinearLayer(WeightBuffer weights, WeightBuffer biases) : linear(std::move(weights), std::move(biases)) {}
+
+    const WeightBuffer& weights() const noexcept { return linear.weights(); }
+    const WeightBuffer& biases() const noexcept { return linear.biases(); }
+
+    trt_types::Tensor* addToNetwork_impl(trt_types::Network* network, trt_types::Tensor* data) {
+        data = linear.addToNetwork_impl(network, data);
+        return network->addActivation(*data, activation_type)->getOutput(0);
+    }
+
+    static constexpr uint64_t fingerprint_impl() {
+        return hash_utils::combine(hash_utils::fnv1a("FusedLinearLayer"), static_cast<uint64_t>(cexpr_utils::to_underlying(at)));
+    }
+
+    static constexpr Cost cost_impl() {
+        Cost c = LinearLayer<bs, in, out, dt>::cost_impl();
+        c.flops += static_cast<int64_t>(bs.max) * dimVolume(out);
+        return c;
+    }
+
+    template<typename V>
+    void forward_impl(const float* x, float* y, float*) {
+        static_assert(dt == trt_types::DataType::kFLOAT, "CPU execution supports kFLOAT only.");
+        cpu_kernels::linear<V, bs.max, dimVolume(in), dimVolume(out), cpu_kernels::ActivationEpilogue<at>>(
+            x, static_cast<const float*>(weights().data()), static_cast<const float*>(biases().data()), y);
+    }
+
+    uint64_t weightsHash_impl(uint64_t seed) const {
+        return linear.weightsHash(seed);
+    }
+
+    void intern_impl(WeightRegistry& registry) {
+        linear.intern(registry);
+    }
+};
+
+/*!
+* Layer specs for `AutoSequential` - layers without their input shape, which is deduced from the
+* previous layer. Each spec maps input shape to output shape (`out`) and to a module (`layer`).
+*/
+namespace layers {
+    /*!
+    * Output shapes after each spec (`[0]` is `in`) - one constexpr pass, no recursion.
+    */
+    template<typename... Specs>
+    constexpr std::array<trt_types::Dims, sizeof...(Specs) + 1> shapes(trt_types::Dims in) {
+        std::array<trt_types::Dims, sizeof...(Specs) + 1> s{in};
+        std::size_t i = 0;
+        ((s[i + 1] = Specs::out(s[i]), ++i), ...);
+        return s;
+    }
+
+    /*!
+    * `LinearLayer` replacing last dimension with `features`.
+    */
+    template<int32_t features>
+    struct Linear {
+        static constexpr trt_types::Dims out(trt_types::Dims in) {
+            in.d[in.nbDims - 1] = features;
+            return in;
+        }
+
+        template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt>
+        using layer = LinearLayer<bs, in, out(in), dt>;
+    };
+
+    template<trt_types::ActivationType at>
+    struct Activation {
+        static constexpr trt_types::Dims out(trt_types::Dims in) { return in; }
+
+        template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt>
+        using layer = ActivationLayer<bs, in, dt, at>;
+    };
+
+    using Relu = Activation<trt_types::ActivationType::kRELU>;
+
+    struct Softmax {
+        static constexpr trt_types::Dims out(trt_types::Dims in) { return in; }
+
+        template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt>
+        using layer = SoftmaxLayer<bs, in, dt>;
+    };
+
+    struct Identity {
+        static constexpr trt_types::Dims out(trt_types::Dims in) { return in; }
+
+        template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt>
+        using layer = IdentityLayer<bs, in, dt>;
+    };
+
+    /*!
+    * Already complete module - its shapes are checked by `Sequential`, not deduced.
+    */
+    template<DerivedFromModule M>
+    struct Use {
+        static constexpr trt_types::Dims out(trt_types::Dims) { return M::out_shape; }
+
+        template<BatchSize, trt_types::Dims, trt_types::DataType>
+        using layer = M;
+    };
+
+    template<typename... Specs>
+    struct Chain;
+} // layers namespace
+
+template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt, typename Is, typename... Specs>
+struct auto_sequential;
+
+template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt, std::size_t... Is, typename... Specs>
+struct auto_sequential<bs, in, dt, std::index_sequence<Is...>, Specs...> {
+    static constexpr auto shapes = layers::shapes<Specs...>(in);
+    using type = Sequential<bs, in, shapes[sizeof...(Specs)], dt, typename Specs::template layer<bs, shapes[Is], dt>...>;
+};
+
+/*!
+* `Sequential` where only the input shape is written, e.g.
+* `AutoSequential<8, Dims{2, {1, 784}}, kFLOAT, layers::Linear<128>, layers::Relu, layers::Linear<10>>`.
+*/
+template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt, typename... Specs>
+requires (sizeof...(Specs) > 0)
+using AutoSequential = typename auto_sequential<bs, in, dt, std::index_sequence_for<Specs...>, Specs...>::type;
+
+namespace layers {
+    /*!
+    * Nested block of specs - becomes a nested `Sequential` (spliced back in by the rewrite pass).
+    */
+    template<typename... Specs>
+    struct Chain {
+        static constexpr trt_types::Dims out(trt_types::Dims in) { return shapes<Specs...>(in)[sizeof...(Specs)]; }
+
+        template<BatchSize bs, trt_types::Dims in, trt_types::DataType dt>
+        using layer = AutoSequential<bs, in, dt, Specs...>;
+    };
+} // layers namespace
+
+/*!
+* Upper bounds on `Module::cost()` - unset fields are unlimited.
+*/
+struct Budget {
+    int64_t max_params = std::numeric_limits<int64_t>::max();
+    int64_t max_weight_bytes = std::numeric_limits<int64_t>::max();
+    int64_t max_flops = std::numeric_limits<int64_t>::max();
+    int64_t max_activation_bytes = std::numeric_limits<int64_t>::max();
+};
+
+/*!
+* Fails compilation naming the exceeded limit, e.g.
+* `static_assert(check_budget<Model, Budget{.max_weight_bytes = 50 << 20, .max_flops = 2'000'000'000}>::value);`
+*/
+template<DerivedFromModule M, Budget budget>
+struct check_budget : std::true_type {
+    static_assert(M::cost().params <= budget.max_params, "Module exceeds parameter budget.");
+    static_assert(M::cost().weight_bytes <= budget.max_weight_bytes, "Module exceeds weight memory budget.");
+    static_assert(M::cost().flops <= budget.max_flops, "Module exceeds FLOP budget.");
+    static_assert(M::cost().activation_bytes <= budget.max_activation_bytes, "Module exceeds activation memory budget.");
+};
+
+/*!
+* Non-failing check, for `if constexpr`/`requires`.
+*/
+template<DerivedFromModule M, Budget budget>
+inline constexpr bool fits_budget = M::cost().params <= budget.max_params && M::cost().weight_bytes <= budget.max_weight_bytes &&
+                                    M::cost().flops <= budget.max_flops && M::cost().activation_bytes <= budget.max_activation_bytes;
+
+/*!
+* Compile-time rewrite pass run by `Sequential` over its children (left to right, greedily):
+* - nested `Sequential`s are spliced in, so folding works across their boundaries,
+* - `IdentityLayer`s are dropped,
+* - `Linear -> Linear` merges into one layer (`W = W1*W2`, `b = b1*W2 + b2`) when that doesn't add FLOPs,
+* - `Linear -> Activation` becomes `FusedLinearLayer`,
+* - library layers are re-instantiated at the enclosing batch range, other modules are copied.
+* Parameters of untouched layers are shared, merged ones are computed once on the host.
+*
+* The plan is a constexpr loop over per-child properties, so instantiation depth doesn't grow with
+* the number of children.
+*/
+namespace rewrite {
+    template<typename T>
+    struct is_linear : std::false_type {};
+
+    template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt>
+    struct is_linear<LinearLayer<bs, in, out, dt>> : std::true_type {};
+
+    template<typename T>
+    struct is_activation : std::false_type {};
+
+    template<BatchSize bs, trt_types::Dims size, trt_types::DataType dt, trt_types::ActivationType at>
+    struct is_activation<ActivationLayer<bs, size, dt, at>> : std::true_type {};
+
+    template<typename T>
+    struct is_softmax : std::false_type {};
+
+    template<BatchSize bs, trt_types::Dims size, trt_types::DataType dt>
+    struct is_softmax<SoftmaxLayer<bs, size, dt>> : std::true_type {};
+
+    template<typename T>
+    struct is_identity : std::false_type {};
+
+    template<BatchSize bs, trt_types::Dims size, trt_types::DataType dt>
+    struct is_identity<IdentityLayer<bs, size, dt>> : std::true_type {};
+
+    template<typename T>
+    struct is_sequential : std::false_type {};
+
+    template<BatchSize bs, trt_types::Dims in, trt_types::Dims out, trt_types::DataType dt, typename M, typename... Ms>
+    struct is_sequential<Sequential<bs, in, out, dt, M, Ms...>> : std::true_type {};
+
+    enum class Kind : uint8_t { kIDENTITY, kLINEAR, kACTIVATION, kOTHER };
+
+    template<typename M>
+    constexpr Kind kind() {
+        if constexpr (is_identity<M>::value)
+            return Kind::kIDENTITY;
+        else if constexpr (is_linear<M>::value)
+            return Kind::kLINEAR;
+        else if constexpr (is_activation<M>::value)
+            return Kind::kACTIVATION;
+        else
+            return Kind::kOTHER;
+    }
+
+    /*!
+    * One lowered child - listed children `[first, last]`, `linears` of them merged, `last` fused in as activation.
+    */
+    struct Step {
+        std::size_t first = 0;
+        std::size_t last = 0;
+        std::size_t linears = 0;
+        bool fused = false;
+    };
+
+    template<std::size_t n>
+    struct Plan {
+        std::array<Step, n> steps{};
+        std::size_t size = 0;
+    };
+
+    /*!
+    * Groups children into steps. Product `[K x H] * [H x N]` is folded only when `K*N <= K*H + H*N`
+    * (no low-rank blow-up) and parameters are host floats.
+    */
+    template<typename... Ms>
+    constexpr Plan<sizeof...(Ms)> plan() {
+        constexpr std::size_t n = sizeof...(Ms);
+        constexpr Kind kinds[] = {kind<Ms>()...};
+        constexpr int64_t ins[] = {dimVolume(Ms::in_shape)...}, outs[] = {dimVolume(Ms::out_shape)...};
+        constexpr bool host[] = {(Ms::data_type == trt_types::DataType::kFLOAT)...};
+
+        Plan<n> p{};
+        std::size_t i = 0;
+        while (i < n) {
+            if (kinds[i] == Kind::kIDENTITY) {
+                ++i;
+                continue;
+            }
+            Step s{i, i, kinds[i] == Kind::kLINEAR ? 1u : 0u, false};
+            for (std::size_t j = i + 1; s.linears && j < n; ++j) {
+                const int64_t H = outs[s.last];             // output of linears merged so far
+                if (kinds[j] == Kind::kIDENTITY)
+                    continue;
+                if (kinds[j] == Kind::kLINEAR && host[i] && ins[i] * outs[j] <= ins[i] * H + H * outs[j]) {
+                    s.last = j;
+                    ++s.linears;
+                    continue;
+                }
+                if (kinds[j] == Kind::kACTIVATION) {
+                    s.last = j;
+                    s.fused = true;
+                }
+                break;
+            }
+            p.steps[p.size++] = s;
+            i = s.last + 1;
+        }
+        return p;
+    }
+
+    /*!
+    * Indices of linears merged by step `s`.
+    */
+    template<Step s, typename... Ms>
+    constexpr std::array<std::size_t, s.linears> linears() {
+        constexpr Kind kinds[] = {kind<Ms>()...};
+        std::array<std::size_t, s.linears> idx{};
+        for (std::size_t i = s.first, k = 0; k < s.linears; ++i)
+            if (kinds[i] == Kind::kLINEAR)
+                idx[k++] = i;
+        return idx;
+    }
+
+    template<BatchSize bs, typename M>
+    auto rebatch(const M& m) {
+        if constexpr (is_linear<M>::value)
+            return LinearLayer<bs, M::in_shape, M::out_shape, M::data_type>(m.weights(), m.biases());
+        else if constexpr (is_activation<M>::value)
+            return ActivationLayer<bs, M::in_shape, M::data_type, M::activation_type>();
+        else if constexpr (is_softmax<M>::value)
+            return SoftmaxLayer<bs, M::in_shape, M::data_type>();
+        else
+            return m;
+    }
+
+    template<BatchSize bs, typename L1, typename L2>
+    auto merge(const L1& l1, const L2& l2) {
+        constexpr std::size_t K = dimVolume(L1::in_shape), H = dimVolume(L1::out_shape), N = dimVolume(L2::out_shape);
+        const auto* w1 = static_cast<const float*>(l1.weights().data());
+        const auto* b1 = static_cast<const float*>(l1.biases().data());
+        const auto* w2 = static_cast<const float*>(l2.weights().data());
+        const auto* b2 = static_cast<const float*>(l2.biases().data());
+
+        // [N x K] = w2[N x H] * w1[H x K], rows of w1^T are the columns `linear` dots against
+        std::vector<float> w1t(K * H), w(N * K), b(N);
+        for (std::size_t h = 0; h < H; ++h)
+            for (std::size_t k = 0; k < K; ++k)
+                w1t[k * H + h] = w1[h * K + k];
+        const std::vector<float> zero(K, 0.f);
+        cpu_kernels::linear<simd_utils::Native, N, H, K>(w2, w1t.data(), zero.data(), w.data());
+        cpu_kernels::linear<simd_utils::Native, 1, H, N>(b1, w2, b2, b.data());
+        return LinearLayer<bs, L1::in_shape, L2::out_shape, L1::data_type>(
+            WeightBuffer::adopt(std::move(w), true), WeightBuffer::adopt(std::move(b), true));
+    }
+
+    template<BatchSize bs, typename L>
+    const L& chain(const L& l) {
+        return l;
+    }
+
+    /*!
+    * Merges a run of linears - recursion depth is the run length, not the number of children.
+    */
+    template<BatchSize bs, typename L1, typename L2, typename... Ls>
+    auto chain(const L1& l1, const L2& l2, const Ls&... ls) {
+        return chain<bs>(merge<bs>(l1, l2), ls...);
+    }
+
+    template<BatchSize bs, typename L, typename A>
+    auto fuse(const L& l, const A&) {
+        return FusedLinearLayer<bs, L::in_shape, L::out_shape, L::data_type, A::activation_type>(l.weights(), l.biases());
+    }
+
+    template<BatchSize bs, Step s, typename... Ms>
+    auto lowerStep(const std::tuple<const Ms&...>& ms) {
+        if constexpr (s.linears <= 1 && !s.fused) {
+            return rebatch<bs>(std::get<s.first>(ms));
+        } else {
+            constexpr auto idx = linears<s, Ms...>();
+            decltype(auto) l = [&]<std::size_t... k>(std::index_sequence<k...>) -> decltype(auto) {
+                return chain<bs>(std::get<idx[k]>(ms)...);
+            }(std::make_index_sequence<s.linears>{});
+            if constexpr (s.fused)
+                return fuse<bs>(l, std::get<s.last>(ms));
+            else
+                return l;
+        }
+    }
+
+    /*!
+    * Listed children with nested `Sequential`s spliced in, by reference.
+    */
+    template<typename M>
+    auto flatten(const M& m) {
+        if constexpr (is_sequential<M>::value)
+            return std::apply([](const auto&... cs) { return std::tuple_cat(flatten(cs)...); }, m.children());
+        else
+            return std::tuple<const M&>(m);
+    }
+
+    template<BatchSize bs, typename M, typename... Ms>
+    auto lowerFlat(const std::tuple<const M&, const Ms&...>& ms) {
+        static constexpr auto p = plan<M, Ms...>();
+        if constexpr (p.size == 0) {
+            return std::make_tuple(IdentityLayer<bs, M::in_shape, M::data_type>());
+        } else {
+            return [&]<std::size_t... g>(std::index_sequence<g...>) {
+                return std::make_tuple(lowerStep<bs, p.steps[g]>(ms)...);
+            }(std::make_index_sequence<p.size>{});
+        }
+    }
+
+    /*!
+    * Checkpoint paths of listed children with nested `Sequential`s spliced in - parallel to `flatten`.
+    */
+    template<typename M>
+    void paths(const M& m, const std::string& name, std::vector<std::string>& out) {
+        if constexpr (is_sequential<M>::value) {
+            const std::string prefix = name.empty() ? "" : name + ".";
+            std::size_t i = 0;
+            std::apply([&](const auto&... cs) { (paths(cs, prefix + std::to_string(i++), out), ...); }, m.children());
+        } else {
+            out.push_back(name);
+        }
+    }
+
+    /*!
+    * Name of each lowered child - path of its first listed child, `first+last` when a step spans several.
+    */
+    template<typename... Ms>
+    std::vector<std::string> stepNames(const std::vector<std::string>& ps) {
+        static constexpr auto p = plan<Ms...>();
+        if constexpr (p.size == 0) {
+            return {ps.front()};
+        } else {
+            std::vector<std::string> names;
+            names.reserve(p.size);
+            for (std::size_t g = 0; g < p.size; ++g) {
+                const Step& s = p.steps[g];
+                names.push_back(s.first == s.last ? ps[s.first] : ps[s.first] + "+" + ps[s.last]);
+            }
+            return names;
+        }
+    }
+
+    /*!
+    * Names of `lower()` results for children listed under `name`.
+    */
+    template<DerivedFromModule M, DerivedFromModule... Ms>
+    std::vector<std::string> names(const std::string& name, const M& m, const Ms&... ms) {
+        const std::string prefix = name.empty() ? "" : name + ".";
+        std::vector<std::string> ps;
+        std::size_t i = 0;
+        paths(m, prefix + std::to_string(i++), ps);
+        (paths(ms, prefix + std::to_string(i++), ps), ...);
+        if constexpr (is_sequential<M>::value || (is_sequential<Ms>::value || ...)) {
+            return [&]<typename... Fs>(std::type_identity<std::tuple<Fs...>>) {
+                return stepNames<std::remove_cvref_t<Fs>...>(ps);
+            }(std::type_identity<decltype(std::tuple_cat(flatten(m), flatten(ms)...))>{});
+        } else {
+            return stepNames<M, Ms...>(ps);
+        }
+    }
+
+    /*!
+    * Lowered children as a tuple - a lone `IdentityLayer` remains if everything was dropped.
+    */
+    template<BatchSize bs, DerivedFromModule M, DerivedFromModule... Ms>
+    auto lower(const M& m, const Ms&... ms) {
+        if constexpr (is_sequential<M>::value || (is_sequential<Ms>::value || ...))
+            return lowerFlat<bs>(std::tuple_cat(flatten(m), flatten(ms)...));
+        else
+            return lowerFlat<bs>(std::tuple<const M&, const Ms&...>(m, ms...));
+    }
+} // rewrite namespace
+
 } // trttl namespace
-#endif //MODULE_HPP
\ No newline at end of file
+#endif //MODULE_HPP
@@ -0,0 +1,213 @@
+#ifndef PLAN_CACHE_HPP
+#define PLAN_CACHE_HPP
+
+#include "util/file_utils.hpp"
+#include "util/hash_utils.hpp"
+#include "tracing.hpp"
+#include <NvInferVersion.h>
+#include <string_view>
+#include <filesystem>
+#include <algorithm>
+#include <type_traits>
+#include <stdexcept>
+#include <optional>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace trttl {
+
+/*!
+* Serialized engine bytes.
+*/
+using Plan = std::vector<char>;
+
+/*!
+* On-disk cache of serialized engines keyed by `Module::fingerprint()` combined with weights hash.
+*
+* Entries carry magic, format/TensorRT versions, key, the builder config they were built with
+* (`describeConfig()` JSON, see `config()`) and checksum - any mismatch is
+* treated as a miss and the file is dropped. Writes go to a temp file that is fsync'ed and
+* renamed, so concurrent processes never observe partial plans. Hits refresh mtime; when the
+* directory grows beyond `max_bytes`, least recently used entries are evicted.
+*/
+class PlanCache {
+private:
+    static constexpr char magic[8] = {'T', 'R', 'T', 'T', 'L', 'P', 'L', 'N'};
+    static constexpr uint32_t format = 4;                   /*!< Bump when entry layout or lowering of modules changes.*/
+    static constexpr uint32_t trt_version = NV_TENSORRT_MAJOR * 1000000 + NV_TENSORRT_MINOR * 10000 +
+                                            NV_TENSORRT_PATCH * 100 + NV_TENSORRT_BUILD;
+
+    struct Header {
+        char magic[8];
+        uint32_t format;
+        uint32_t trt_version;
+        uint64_t key;
+        uint64_t size;
+        uint64_t checksum;                                  /*!< Of config and payload.*/
+        uint32_t config_size;                               /*!< Config text between header and payload.*/
+        uint32_t reserved;
+    };
+
+    std::filesystem::path dir;
+    uint64_t max_bytes;
+    std::mutex mtx;                                         /*!< Serializes eviction within process.*/
+    std::atomic<uint64_t> hit_count{0};
+    std::atomic<uint64_t> miss_count{0};
+
+    std::filesystem::path entry(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.plan", static_cast<unsigned long long>(key));
+        return dir / name;
+    }
+
+    void evict() {
+        std::lock_guard<std::mutex> lock(mtx);
+        struct Item {
+            std::filesystem::path path;
+            std::filesystem::file_time_type time;
+            uint64_t size;
+        };
+        std::vector<Item> items;
+        uint64_t total = 0;
+        std::error_code ec;
+        for (const auto& e : std::filesystem::directory_iterator(dir, ec)) {
+            if (e.path().extension() != ".plan")
+                continue;
+            Item it{e.path(), e.last_write_time(ec), e.file_size(ec)};
+            if (ec)
+                continue;
+            total += it.size;
+            items.push_back(std::move(it));
+        }
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.time < b.time; });
+        for (std::size_t i = 0; total > max_bytes && i + 1 < items.size(); ++i) {
+            std::filesystem::remove(items[i].path, ec);
+            total -= items[i].size;
+        }
+    }
+
+    /*!
+    * Reads and validates header of `key`'s entry, leaving `fin` at the config text.
+    */
+    bool open(uint64_t key, std::ifstream& fin, Header& h) const {
+        fin.open(entry(key), std::ios::binary);
+        return fin && fin.read(reinterpret_cast<char*>(&h), sizeof(h)) && std::memcmp(h.magic, magic, sizeof(magic)) == 0 &&
+               h.format == format && h.trt_version == trt_version && h.key == key;
+    }
+
+public:
+    /*!
+    * @param directory - created if missing
+    * @param max_bytes - soft limit of directory size (newest entry is always kept)
+    */
+    explicit PlanCache(std::filesystem::path directory, uint64_t max_bytes = 4ull << 30)
+        : dir(std::move(directory)), max_bytes(max_bytes) {
+        std::filesystem::create_directories(dir);
+    }
+
+    /*!
+    * Returns cached plan, or nothing if missing/stale/corrupted.
+    */
+    std::optional<Plan> get(uint64_t key) {
+        TraceSpan span("serialize", "PlanCache::get");
+        const auto path = entry(key);
+        std::ifstream fin;
+        Header h{};
+        Plan plan;
+        bool valid = open(key, fin, h);
+        if (valid) {
+            std::string config(h.config_size, '\0');
+            plan.resize(h.size);
+            valid = fin.read(config.data(), static_cast<std::streamsize>(config.size())) &&
+                    fin.read(plan.data(), static_cast<std::streamsize>(h.size)) &&
+                    fin.peek() == std::char_traits<char>::eof() &&
+                    hash_utils::hash_bytes(plan.data(), plan.size(), hash_utils::hash_bytes(config.data(), config.size())) == h.checksum;
+        }
+        fin.close();
+
+        std::error_code ec;
+        if (!valid) {
+            std::filesystem::remove(path, ec);
+            miss_count.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+        hit_count.fetch_add(1, std::memory_order_relaxed);
+        return plan;
+    }
+
+    /*!
+    * Builder config recorded with `key`'s plan (empty if none was given), nothing if there is no valid entry.
+    * Reads the header only - payload checksum is verified by `get()`.
+    */
+    std::optional<std::string> config(uint64_t key) const {
+        std::ifstream fin;
+        Header h{};
+        if (!open(key, fin, h))
+            return std::nullopt;
+        std::string config(h.config_size, '\0');
+        if (!fin.read(config.data(), static_cast<std::streamsize>(config.size())))
+            return std::nullopt;
+        return config;
+    }
+
+    /*!
+    * Atomically stores plan under `key` with the `config` it was built with, then enforces size limit.
+    */
+    void put(uint64_t key, const void* data, std::size_t size, std::string_view config = {}) {
+        TraceSpan span("serialize", "PlanCache::put");
+        Header h{};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        h.format = format;
+        h.trt_version = trt_version;
+        h.key = key;
+        h.size = size;
+        h.checksum = hash_utils::hash_bytes(data, size, hash_utils::hash_bytes(config.data(), config.size()));
+        h.config_size = static_cast<uint32_t>(config.size());
+
+        file_utils::atomic_write(entry(key), {{&h, sizeof(h)}, {config.data(), config.size()}, {data, size}});
+        evict();
+    }
+
+    /*!
+    * Returns cached plan or calls `build` (returning `IHostMemory`-like pointer or `Plan`) and stores result.
+    * Builder is not invoked on a hit.
+    */
+    template<typename F>
+    Plan getOrBuild(uint64_t key, F&& build, std::string_view config = {}) {
+        if (auto plan = get(key))
+            return std::move(*plan);
+
+        auto built = build();
+        Plan plan;
+        if constexpr (std::is_same_v<std::decay_t<decltype(built)>, Plan>) {
+            plan = std::move(built);
+        } else {
+            if (!built)
+                throw std::runtime_error("Engine build failed.");
+            const auto* p = static_cast<const char*>(built->data());
+            plan.assign(p, p + built->size());
+        }
+        put(key, plan.data(), plan.size(), config);
+        return plan;
+    }
+
+    void clear() {
+        std::error_code ec;
+        for (const auto& e : std::filesystem::directory_iterator(dir, ec))
+            if (e.path().extension() == ".plan")
+                std::filesystem::remove(e.path(), ec);
+    }
+
+    uint64_t hits() const noexcept { return hit_count.load(std::memory_order_relaxed); }
+    uint64_t misses() const noexcept { return miss_count.load(std::memory_order_relaxed); }
+};
+
+} // trttl namespace
+#endif // PLAN_CACHE_HPP
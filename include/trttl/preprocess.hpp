@@ -0,0 +1,85 @@
+#ifndef PREPROCESS_HPP
+#define PREPROCESS_HPP
+
+#include "util/cpu_kernels.hpp"
+#include "util/simd_utils.hpp"
+#include "util/trt_types.hpp"
+#include "modules.hpp"
+#include "buffers.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <span>
+
+namespace trttl {
+
+/*!
+* Host preprocessing of 8-bit interleaved (HWC) images into `M`'s input - u8 to float conversion,
+* per-channel `(x - mean) / std` and transposition to CHW in one pass, written straight into a
+* batch slot (`InputBuffer<M>`, `Batcher::submit(fill)`) or any `M::in_shape` sample.
+* Engine inputs bind as kFLOAT for every module precision (see `Network::configure`).
+*
+* @tparam M - module taking `[C, H, W]` samples
+* @tparam V - `simd_utils` instruction set, `simd_utils::Scalar` is the reference path
+*/
+template<DerivedFromModule M, typename V = simd_utils::Native>
+requires (M::in_shape.nbDims == 3 && M::in_shape.d[0] > 0 && M::in_shape.d[0] <= 4 &&
+          (M::data_type == trt_types::DataType::kFLOAT || M::data_type == trt_types::DataType::kHALF ||
+           M::data_type == trt_types::DataType::kINT8))
+class Preprocessor {
+public:
+    static constexpr std::size_t channels = static_cast<std::size_t>(M::in_shape.d[0]);
+    static constexpr int32_t height = M::in_shape.d[1];
+    static constexpr int32_t width = M::in_shape.d[2];
+    static constexpr std::size_t pixels = static_cast<std::size_t>(height) * static_cast<std::size_t>(width);
+    static constexpr std::size_t image_size = pixels * channels;           /*!< Bytes of one HWC image.*/
+    static constexpr std::size_t sample_size = static_cast<std::size_t>(dimVolume(M::in_shape));
+
+    using Image = std::span<const uint8_t, image_size>;
+    using Sample = std::span<float, sample_size>;
+
+private:
+    std::array<float, channels> scale;
+    std::array<float, channels> bias;
+
+public:
+    /*!
+    * @param mean - per-channel mean in pixel units (ImageNet: `{123.675, 116.28, 103.53}`)
+    * @param stddev - per-channel standard deviation in pixel units (ImageNet: `{58.395, 57.12, 57.375}`)
+    */
+    Preprocessor(const std::array<float, channels>& mean, const std::array<float, channels>& stddev) {
+        for (std::size_t c = 0; c < channels; ++c) {
+            scale[c] = 1.f / stddev[c];
+            bias[c] = -mean[c] / stddev[c];
+        }
+    }
+
+    /*!
+    * Plain `x / 255` scaling.
+    */
+    Preprocessor() {
+        scale.fill(1.f / 255.f);
+        bias.fill(0.f);
+    }
+
+    void run(Image image, Sample sample) const {
+        cpu_kernels::normalize_hwc<V, pixels, channels>(image.data(), sample.data(), scale.data(), bias.data());
+    }
+
+    /*!
+    * Writes `image` into `slot` of a whole-batch buffer.
+    */
+    void run(Image image, InputBuffer<M>& batch, int32_t slot) const {
+        run(image, batch.sample(slot));
+    }
+
+    /*!
+    * `Batcher::submit(fill)` callback - `batcher.submit(pre.fill(image))`. `image` must outlive the call.
+    */
+    auto fill(Image image) const {
+        return [this, image](Sample sample) { run(image, sample); };
+    }
+};
+
+} // trttl namespace
+#endif // PREPROCESS_HPP
@@ -0,0 +1,274 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "util/hash_utils.hpp"
+#include <NvInfer.h>
+#include <string_view>
+#include <algorithm>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <bit>
+
+namespace trttl {
+
+/*!
+* Lock-free log-linear (HDR-style) histogram of nanosecond latencies - exact below 64 ns,
+* 32 sub-buckets per power of two above (~3% relative error), saturating at ~18 minutes.
+* `record()` is a couple of relaxed atomic adds; reads are consistent only once writers stop.
+*/
+class LatencyHistogram {
+public:
+    static constexpr uint32_t sub_bits = 5;
+    static constexpr uint64_t sub_count = uint64_t{1} << sub_bits;
+    static constexpr uint32_t max_bits = 40;
+    static constexpr std::size_t bucket_count = 2 * sub_count + (max_bits - sub_bits - 1) * sub_count;
+
+private:
+    std::atomic<uint64_t> buckets[bucket_count] = {};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maximum{0};
+
+public:
+    static constexpr std::size_t bucketOf(uint64_t ns) noexcept {
+        ns = std::min(ns, (uint64_t{1} << max_bits) - 1);
+        if (ns < 2 * sub_count)
+            return static_cast<std::size_t>(ns);
+        const uint32_t shift = static_cast<uint32_t>(std::bit_width(ns)) - sub_bits - 1;
+        return static_cast<std::size_t>(sub_count * shift + (ns >> shift));
+    }
+
+    /*!
+    * Smallest value falling into bucket `b`.
+    */
+    static constexpr uint64_t lowerBound(std::size_t b) noexcept {
+        if (b < 2 * sub_count)
+            return b;
+        const uint64_t shift = b / sub_count - 1;
+        return (b % sub_count + sub_count) << shift;    // mantissa in [sub_count, 2 * sub_count)
+    }
+
+    static constexpr uint64_t width(std::size_t b) noexcept {
+        return b < 2 * sub_count ? 1 : uint64_t{1} << (b / sub_count - 1);
+    }
+
+    void record(uint64_t ns) noexcept {
+        buckets[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t m = maximum.load(std::memory_order_relaxed);
+        while (ns > m && !maximum.compare_exchange_weak(m, ns, std::memory_order_relaxed)) {}
+    }
+
+    uint64_t count() const noexcept { return total.load(std::memory_order_relaxed); }
+    uint64_t sumNs() const noexcept { return sum.load(std::memory_order_relaxed); }
+    uint64_t maxNs() const noexcept { return maximum.load(std::memory_order_relaxed); }
+
+    /*!
+    * Value at quantile `q` in [0, 1] - middle of its bucket, capped by the max seen. 0 when empty.
+    */
+    uint64_t percentile(double q) const noexcept {
+        const uint64_t n = count();
+        if (n == 0)
+            return 0;
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(n) + 0.5));
+        uint64_t seen = 0;
+        for (std::size_t b = 0; b < bucket_count; ++b) {
+            seen += buckets[b].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return std::min(lowerBound(b) + width(b) / 2, maxNs());
+        }
+        return maxNs();
+    }
+};
+
+/*!
+* Per-layer summary exported by `LayerProfiler`.
+*/
+struct LayerStats {
+    std::string name;
+    uint64_t count;
+    double mean_ms;
+    double p50_ms;
+    double p99_ms;
+    double p999_ms;
+    double max_ms;
+};
+
+/*!
+* `IProfiler` aggregating `reportLayerTime` calls into one `LatencyHistogram` per layer name.
+* Layers live in a fixed open-addressing table keyed by name hash - lookup and recording are
+* lock-free, a layer's histogram is allocated once by the thread reporting it first.
+* Can be attached to several execution contexts. Layer names come from `Module::addToNetwork` naming.
+*/
+class LayerProfiler : public nvinfer1::IProfiler {
+private:
+    struct Slot {
+        std::atomic<uint64_t> key{0};
+        std::atomic<LatencyHistogram*> histogram{nullptr};
+        std::string name;                               /*!< Written before `histogram` is published.*/
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t capacity;
+    std::atomic<uint64_t> dropped_count{0};
+
+    static uint64_t key(std::string_view name) noexcept {
+        const uint64_t h = hash_utils::fnv1a(name);
+        return h == 0 ? 1 : h;                          // 0 marks a free slot
+    }
+
+    LatencyHistogram* find(std::string_view name, bool insert) {
+        const uint64_t k = key(name);
+        for (std::size_t i = 0, s = k & (capacity - 1); i < capacity; ++i, s = (s + 1) & (capacity - 1)) {
+            Slot& slot = slots[s];
+            uint64_t current = slot.key.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (!insert)
+                    return nullptr;
+                auto h = std::make_unique<LatencyHistogram>();
+                std::string owned(name);
+                if (slot.key.compare_exchange_strong(current, k, std::memory_order_acq_rel)) {
+                    slot.name = std::move(owned);
+                    slot.histogram.store(h.get(), std::memory_order_release);
+                    return h.release();
+                }
+            }
+            if (current == k) {
+                LatencyHistogram* h;
+                while (!(h = slot.histogram.load(std::memory_order_acquire)))
+                    std::this_thread::yield();          // another thread is publishing this layer
+                return h;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename F>
+    void for_each(F&& f) const {
+        for (std::size_t s = 0; s < capacity; ++s)
+            if (const auto* h = slots[s].histogram.load(std::memory_order_acquire))
+                f(slots[s].name, *h);
+    }
+
+    static void escaped(std::ostream& out, std::string_view s, bool json) {
+        for (const char c : s) {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (c == '\n')
+                out << "\\n";
+            else if (json && static_cast<unsigned char>(c) < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+    }
+
+    static std::ostream& series(std::ostream& out, std::string_view metric, std::string_view suffix,
+                                std::string_view layer, std::string_view quantile) {
+        out << metric << suffix << "{layer=\"";
+        escaped(out, layer, false);
+        out << '"';
+        if (!quantile.empty())
+            out << ",quantile=\"" << quantile << '"';
+        return out << "} ";
+    }
+
+public:
+    /*!
+    * @param max_layers - distinct layer names to expect; table holds at least twice as many,
+    *                     reports of names that don't fit are counted by `dropped()`
+    */
+    explicit LayerProfiler(std::size_t max_layers = 1024)
+        : capacity(std::bit_ceil(std::max<std::size_t>(max_layers, 2) * 2)) {
+        slots.reset(new Slot[capacity]);
+    }
+
+    LayerProfiler(const LayerProfiler&) = delete;
+    LayerProfiler& operator=(const LayerProfiler&) = delete;
+
+    ~LayerProfiler() override {
+        for (std::size_t s = 0; s < capacity; ++s)
+            delete slots[s].histogram.load(std::memory_order_relaxed);
+    }
+
+    void reportLayerTime(const char* layerName, float ms) noexcept override {
+        LatencyHistogram* h = nullptr;
+        try {
+            h = find(layerName ? layerName : "", true);
+        } catch (...) {}
+        if (!h) {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        h->record(static_cast<uint64_t>(std::max(0.0, static_cast<double>(ms) * 1e6 + 0.5)));
+    }
+
+    /*!
+    * Histogram of `name` or `nullptr` if it was never reported.
+    */
+    const LatencyHistogram* histogram(std::string_view name) {
+        return find(name, false);
+    }
+
+    /*!
+    * Summary of every layer, sorted by name.
+    */
+    std::vector<LayerStats> stats() const {
+        std::vector<LayerStats> r;
+        for_each([&](const std::string& name, const LatencyHistogram& h) {
+            const uint64_t n = h.count();
+            r.push_back({name, n, n ? static_cast<double>(h.sumNs()) / static_cast<double>(n) * 1e-6 : 0.0,
+                         static_cast<double>(h.percentile(0.5)) * 1e-6, static_cast<double>(h.percentile(0.99)) * 1e-6,
+                         static_cast<double>(h.percentile(0.999)) * 1e-6, static_cast<double>(h.maxNs()) * 1e-6});
+        });
+        std::sort(r.begin(), r.end(), [](const LayerStats& a, const LayerStats& b) { return a.name < b.name; });
+        return r;
+    }
+
+    /*!
+    * `{"layers": [{"name", "count", "mean_ms", "p50_ms", "p99_ms", "p999_ms", "max_ms"}, ...]}`.
+    */
+    void writeJson(std::ostream& out) const {
+        out << "{\"layers\": [";
+        bool first = true;
+        for (const auto& s : stats()) {
+            out << (first ? "\n" : ",\n") << "  {\"name\": \"";
+            escaped(out, s.name, true);
+            out << "\", \"count\": " << s.count << ", \"mean_ms\": " << s.mean_ms << ", \"p50_ms\": " << s.p50_ms
+                << ", \"p99_ms\": " << s.p99_ms << ", \"p999_ms\": " << s.p999_ms << ", \"max_ms\": " << s.max_ms << "}";
+            first = false;
+        }
+        out << (first ? "]}\n" : "\n]}\n");
+    }
+
+    /*!
+    * Prometheus text exposition - one summary (seconds) labelled by layer.
+    */
+    void writePrometheus(std::ostream& out, std::string_view metric = "trttl_layer_latency_seconds") const {
+        out << "# HELP " << metric << " TensorRT per-layer execution time.\n# TYPE " << metric << " summary\n";
+        for (const auto& s : stats()) {
+            series(out, metric, "", s.name, "0.5") << s.p50_ms * 1e-3 << '\n';
+            series(out, metric, "", s.name, "0.99") << s.p99_ms * 1e-3 << '\n';
+            series(out, metric, "", s.name, "0.999") << s.p999_ms * 1e-3 << '\n';
+            series(out, metric, "_sum", s.name, "") << s.mean_ms * static_cast<double>(s.count) * 1e-3 << '\n';
+            series(out, metric, "_count", s.name, "") << s.count << '\n';
+        }
+    }
+
+    /*!
+    * Reports lost because the layer table was full.
+    */
+    uint64_t dropped() const noexcept {
+        return dropped_count.load(std::memory_order_relaxed);
+    }
+};
+
+} // trttl namespace
+#endif // PROFILER_HPP
@@ -0,0 +1,285 @@
+#ifndef ROTATING_LOG_HPP
+#define ROTATING_LOG_HPP
+
+#include "util/trt_types.hpp"
+#include "util/cexpr_utils.hpp"
+#include <condition_variable>
+#include <unordered_map>
+#include <filesystem>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+
+namespace trttl {
+
+/*!
+* When `RotatingFileLog` hands its buffer to the kernel - flags can be combined.
+* The buffer is also written out when full, on rotation and on destruction.
+*/
+enum class FlushPolicy : uint8_t {
+    kLINE = 1,          /*!< After every line (old `FileLog` behaviour).*/
+    kBYTES = 2,         /*!< Once `flush_bytes` are buffered.*/
+    kPERIODIC = 4,      /*!< At most `flush_ms` after the first buffered line, even if the logger goes quiet.*/
+    kERROR = 8          /*!< After kERROR/kINTERNAL_ERROR lines.*/
+};
+
+constexpr FlushPolicy operator|(FlushPolicy a, FlushPolicy b) noexcept {
+    return static_cast<FlushPolicy>(cexpr_utils::to_underlying(a) | cexpr_utils::to_underlying(b));
+}
+
+constexpr bool operator&(FlushPolicy a, FlushPolicy b) noexcept {
+    return (cexpr_utils::to_underlying(a) & cexpr_utils::to_underlying(b)) != 0;
+}
+
+/*!
+* `RotatingFileLog` configuration (template parameter, so every logger type can log elsewhere).
+*/
+struct LogFileConfig {
+    char path[256] = "trt.log";
+    std::size_t max_bytes = std::size_t{64} << 20;          /*!< Rotate before file grows past this, 0 - never.*/
+    int64_t max_age_s = 0;                                  /*!< Rotate files older than this, 0 - never.*/
+    uint32_t keep = 5;                                      /*!< Rotated files kept as `path.1` (newest) .. `path.keep`.*/
+    FlushPolicy flush = FlushPolicy::kBYTES | FlushPolicy::kPERIODIC | FlushPolicy::kERROR;
+    std::size_t flush_bytes = std::size_t{64} << 10;
+    int64_t flush_ms = 1000;
+    std::size_t buffer_bytes = std::size_t{1} << 20;        /*!< User-space buffer, split into 64 KiB blocks.*/
+
+    bool operator==(const LogFileConfig&) const = default;
+};
+
+/*!
+* Append-only log file shared by every `RotatingFileLog` of the same path in the process.
+* Lines are copied into fixed blocks and all filled blocks go out in one `writev` on an
+* `O_APPEND` descriptor. Rotation renames `path` -> `path.1` -> ... at batch boundaries,
+* so a batch is never split between files. Write errors drop the batch (logging never throws);
+* when the next file can't be opened rotation is skipped and retried on the following flush.
+* With `FlushPolicy::kPERIODIC` a flusher thread writes out whatever a quiet logger left buffered.
+*/
+class LogFile {
+private:
+    static constexpr std::size_t block_size = std::size_t{64} << 10;
+
+    LogFileConfig config;
+    std::mutex mtx;
+    int fd = -1;
+    std::size_t file_bytes = 0;
+    std::chrono::system_clock::time_point opened;
+
+    std::condition_variable flusher_cv;
+    bool stopping = false;
+    std::thread flusher;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t block = 0;                                  /*!< Block being filled.*/
+    std::size_t used = 0;                                   /*!< Bytes used in it.*/
+    std::size_t buffered = 0;
+    uint64_t dropped = 0;
+
+    void openFile() {
+        fd = ::open(config.path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0)
+            throw std::ios_base::failure(std::string("Failed to open log file: ") + config.path);
+        struct stat st;
+        file_bytes = ::fstat(fd, &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+        opened = std::chrono::system_clock::now();
+    }
+
+    /*!
+    * Opens the next file as `path.next` before shifting anything - if that fails (e.g. out of descriptors)
+    * every file stays in place and writes continue to the current one.
+    */
+    void rotate() {
+        const std::string base = config.path;
+        const int next = ::open((base + ".next").c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+        if (next < 0)
+            return;
+        std::error_code ec;
+        if (config.keep == 0) {
+            std::filesystem::remove(base, ec);
+        } else {
+            std::filesystem::remove(base + "." + std::to_string(config.keep), ec);
+            for (uint32_t k = config.keep; k > 1; --k)
+                std::filesystem::rename(base + "." + std::to_string(k - 1), base + "." + std::to_string(k), ec);
+            std::filesystem::rename(base, base + ".1", ec);
+        }
+        std::filesystem::rename(base + ".next", base, ec);
+        ::close(fd);
+        fd = next;
+        file_bytes = 0;
+        opened = std::chrono::system_clock::now();
+    }
+
+    bool due(std::size_t bytes) const {
+        if (file_bytes == 0)
+            return false;
+        if (config.max_bytes && file_bytes + bytes > config.max_bytes)
+            return true;
+        return config.max_age_s && std::chrono::system_clock::now() - opened >= std::chrono::seconds(config.max_age_s);
+    }
+
+    void flushLocked() {
+        if (buffered == 0)
+            return;
+        if (due(buffered))
+            rotate();                                       // on failure the batch still goes to the current file
+
+        iovec iov[IOV_MAX];
+        const std::size_t n = std::min<std::size_t>(block + (used ? 1 : 0), IOV_MAX);
+        for (std::size_t b = 0; b < n; ++b)
+            iov[b] = {blocks[b].get(), b == block ? used : block_size};
+
+        std::size_t first = 0;
+        while (first < n) {
+            const ssize_t w = ::writev(fd, iov + first, static_cast<int>(n - first));
+            if (w < 0) {
+                if (errno == EINTR)
+                    continue;
+                std::size_t lost = 0;
+                for (std::size_t b = first; b < n; ++b)
+                    lost += iov[b].iov_len;
+                dropped += lost;
+                break;
+            }
+            file_bytes += static_cast<std::size_t>(w);
+            auto left = static_cast<std::size_t>(w);
+            while (first < n && left >= iov[first].iov_len)
+                left -= iov[first++].iov_len;
+            if (first < n) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+        reset();
+    }
+
+    /*!
+    * Writes out the buffer `flush_ms` after the first line following a flush.
+    */
+    void flushPeriodically() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            flusher_cv.wait(lock, [this] { return stopping || buffered > 0; });
+            if (stopping || flusher_cv.wait_for(lock, std::chrono::milliseconds(config.flush_ms), [this] { return stopping; }))
+                return;
+            flushLocked();
+        }
+    }
+
+    void reset() noexcept {
+        block = 0;
+        used = 0;
+        buffered = 0;
+    }
+
+public:
+    explicit LogFile(const LogFileConfig& config) : config(config) {
+        const std::size_t n = std::clamp<std::size_t>(config.buffer_bytes / block_size, 1, IOV_MAX);
+        blocks.reserve(n);
+        for (std::size_t b = 0; b < n; ++b)
+            blocks.emplace_back(new char[block_size]);
+        openFile();
+        if (config.flush & FlushPolicy::kPERIODIC)
+            flusher = std::thread(&LogFile::flushPeriodically, this);
+    }
+
+    LogFile(const LogFile&) = delete;
+    LogFile& operator=(const LogFile&) = delete;
+
+    ~LogFile() {
+        if (flusher.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stopping = true;
+            }
+            flusher_cv.notify_one();
+            flusher.join();
+        }
+        flushLocked();
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    /*!
+    * Shared file for `config.path` - every sink of one path must use the same settings.
+    * @throws std::invalid_argument if the file is already open with a different config
+    */
+    static std::shared_ptr<LogFile> open(const LogFileConfig& config) {
+        static std::mutex registry_mtx;
+        static std::unordered_map<std::string, std::weak_ptr<LogFile>> registry;
+        std::lock_guard<std::mutex> lock(registry_mtx);
+        auto& slot = registry[std::filesystem::absolute(config.path).lexically_normal().string()];
+        auto file = slot.lock();
+        if (!file) {
+            file = std::make_shared<LogFile>(config);
+            slot = file;
+            return file;
+        }
+        LogFileConfig settings = config;                    // path spelling may differ, the file is the same
+        std::memcpy(settings.path, file->config.path, sizeof(settings.path));
+        if (!(settings == file->config))
+            throw std::invalid_argument(std::string("Log file already open with different settings: ") + config.path);
+        return file;
+    }
+
+    /*!
+    * Buffers complete line(s) and applies flush policy.
+    */
+    void append(const char* data, std::size_t size, uint32_t severity) {
+        std::unique_lock<std::mutex> lock(mtx);
+        const bool idle = buffered == 0;
+        while (size > 0) {
+            if (used == block_size) {
+                if (block + 1 == blocks.size())
+                    flushLocked();
+                else
+                    ++block, used = 0;
+            }
+            const std::size_t n = std::min(size, block_size - used);
+            std::memcpy(blocks[block].get() + used, data, n);
+            used += n;
+            buffered += n;
+            data += n;
+            size -= n;
+        }
+
+        const FlushPolicy p = config.flush;
+        if ((p & FlushPolicy::kLINE) ||
+            ((p & FlushPolicy::kBYTES) && buffered >= config.flush_bytes) ||
+            ((p & FlushPolicy::kERROR) && severity <= static_cast<uint32_t>(trt_types::Severity::kERROR))) {
+            flushLocked();
+        } else if (idle && buffered > 0 && flusher.joinable()) {
+            lock.unlock();
+            flusher_cv.notify_one();
+        }
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> lock(mtx);
+        flushLocked();
+    }
+
+    /*!
+    * Bytes lost to write errors.
+    */
+    uint64_t droppedBytes() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return dropped;
+    }
+};
+
+} // trttl namespace
+#endif // ROTATING_LOG_HPP
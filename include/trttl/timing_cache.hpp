@@ -0,0 +1,138 @@
+#ifndef TIMING_CACHE_HPP
+#define TIMING_CACHE_HPP
+
+#include "util/file_utils.hpp"
+#include "util/trt_types.hpp"
+#include "weights.hpp"
+#include <NvInfer.h>
+#include <filesystem>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace trttl {
+
+/*!
+* Builder timing cache persisted in a single file and shared by builds across processes.
+*
+* File is mmapped and handed to `createTimingCache` on attach. After a build the on-disk cache
+* is re-read under an exclusive `flock` on `<path>.lock`, the build's cache is combined into it
+* and the result is written to a temp file that is fsync'ed and renamed - concurrent builders
+* merge their entries instead of overwriting each other. Rejected files (corrupt, other
+* device/TensorRT version) are replaced by an empty cache.
+*
+* TensorRT 8.6 exposes no per-tactic counters, so hits/misses are counted per build: a hit is
+* a build that added no entries to the cache it started from.
+*/
+class TimingCache {
+public:
+    /*!
+    * Cache attached to a builder config - must outlive the build.
+    */
+    struct Attached {
+        std::unique_ptr<nvinfer1::ITimingCache> cache;
+        std::size_t loaded_bytes = 0;                   /*!< Serialized size before the build.*/
+    };
+
+private:
+    std::filesystem::path path;
+    std::filesystem::path lock_path;
+    bool ignore_mismatch;
+    std::mutex mtx;                                     /*!< Serializes saves within process.*/
+    std::atomic<uint64_t> hit_count{0};
+    std::atomic<uint64_t> miss_count{0};
+    std::atomic<uint64_t> reject_count{0};
+    std::atomic<uint64_t> file_bytes{0};
+
+    static std::size_t serializedSize(const nvinfer1::ITimingCache& cache) {
+        std::unique_ptr<trt_types::Memory> blob(cache.serialize());
+        return blob ? blob->size() : 0;
+    }
+
+    /*!
+    * Cache created from current file contents, nothing if file is missing or empty.
+    */
+    std::unique_ptr<nvinfer1::ITimingCache> load(const trt_types::BuilderConf& config) {
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+            return nullptr;
+        const MappedFile file(path.string());
+        if (file.size() == 0)
+            return nullptr;
+        std::unique_ptr<nvinfer1::ITimingCache> cache(config.createTimingCache(file.data(), file.size()));
+        if (!cache)
+            reject_count.fetch_add(1, std::memory_order_relaxed);
+        return cache;
+    }
+
+public:
+    /*!
+    * @param path - cache file, created on first save
+    * @param ignore_mismatch - accept caches recorded on a different device (timings may be off)
+    */
+    explicit TimingCache(std::filesystem::path path, bool ignore_mismatch = false)
+        : path(std::move(path)), ignore_mismatch(ignore_mismatch) {
+        lock_path = this->path;
+        lock_path += ".lock";
+    }
+
+    TimingCache(const TimingCache&) = delete;
+    TimingCache& operator=(const TimingCache&) = delete;
+
+    /*!
+    * Loads cache file (or starts empty) and attaches it to `config`.
+    */
+    Attached attach(trt_types::BuilderConf& config) {
+        Attached a{load(config)};
+        if (a.cache && !config.setTimingCache(*a.cache, ignore_mismatch)) {
+            reject_count.fetch_add(1, std::memory_order_relaxed);
+            a.cache.reset();
+        }
+        if (!a.cache) {
+            a.cache.reset(config.createTimingCache(nullptr, 0));
+            if (!a.cache || !config.setTimingCache(*a.cache, ignore_mismatch))
+                throw std::runtime_error("Failed to create timing cache.");
+        }
+        a.loaded_bytes = serializedSize(*a.cache);
+        return a;
+    }
+
+    /*!
+    * Merges cache of a finished build into the file.
+    */
+    void save(const trt_types::BuilderConf& config, const Attached& built) {
+        if (!built.cache)
+            return;
+        const bool grew = serializedSize(*built.cache) != built.loaded_bytes;
+        (grew ? miss_count : hit_count).fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> guard(mtx);
+        const file_utils::FileLock lock(lock_path);
+        auto merged = load(config);
+        if (merged && !merged->combine(*built.cache, ignore_mismatch)) {
+            reject_count.fetch_add(1, std::memory_order_relaxed);
+            merged.reset();
+        }
+        if (!merged && !grew && std::filesystem::exists(path))
+            return;                                     // nothing new, keep whatever other builders wrote
+
+        std::unique_ptr<trt_types::Memory> blob((merged ? *merged : *built.cache).serialize());
+        if (!blob)
+            throw std::runtime_error("Failed to serialize timing cache.");
+        file_utils::atomic_write(path, {{blob->data(), blob->size()}});
+        file_bytes.store(blob->size(), std::memory_order_relaxed);
+    }
+
+    const std::filesystem::path& file() const noexcept { return path; }
+
+    uint64_t hits() const noexcept { return hit_count.load(std::memory_order_relaxed); }
+    uint64_t misses() const noexcept { return miss_count.load(std::memory_order_relaxed); }
+    uint64_t rejected() const noexcept { return reject_count.load(std::memory_order_relaxed); }
+    uint64_t bytes() const noexcept { return file_bytes.load(std::memory_order_relaxed); }
+};
+
+} // trttl namespace
+#endif // TIMING_CACHE_HPP
@@ -0,0 +1,200 @@
+#ifndef TRACING_HPP
+#define TRACING_HPP
+
+#include <string_view>
+#include <type_traits>
+#include <filesystem>
+#include <algorithm>
+#include <ostream>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <mutex>
+
+namespace trttl {
+
+/*!
+* Build tracing is compiled in with `-DTRTTL_TRACING` (CMake `TRTTL_TRACING=ON`),
+* otherwise `TraceSpan` is an empty type and spans compile to nothing.
+*/
+#if defined(TRTTL_TRACING)
+inline constexpr bool tracing_enabled = true;
+#else
+inline constexpr bool tracing_enabled = false;
+#endif
+
+/*!
+* Finished span. `category` and `name` must have static storage (literals, `Module::label()`).
+*/
+struct TraceEvent {
+    std::string_view category;
+    std::string_view name;
+    std::string detail;                                 /*!< Module path, job name, file...*/
+    uint64_t start_ns;
+    uint64_t duration_ns;
+};
+
+/*!
+* Collects spans into per-thread buffers and dumps them as Chrome `trace_event` JSON
+* (chrome://tracing, https://ui.perfetto.dev). Buffers outlive their threads until `clear()`.
+*/
+class Tracer {
+private:
+    struct Buffer {
+        std::mutex mtx;                                 /*!< Uncontended except while dumping.*/
+        std::vector<TraceEvent> events;
+        uint32_t tid;
+    };
+
+    struct Registry {
+        std::mutex mtx;
+        std::vector<std::shared_ptr<Buffer>> buffers;
+    };
+
+    static Registry& registry() {
+        static Registry r;
+        return r;
+    }
+
+    static Buffer& local() {
+        thread_local const std::shared_ptr<Buffer> buffer = [] {
+            auto& r = registry();
+            auto b = std::make_shared<Buffer>();
+            std::lock_guard<std::mutex> lock(r.mtx);
+            b->tid = static_cast<uint32_t>(r.buffers.size() + 1);
+            r.buffers.push_back(b);
+            return b;
+        }();
+        return *buffer;
+    }
+
+    static void escaped(std::ostream& out, std::string_view s) {
+        for (const char c : s) {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+    }
+
+public:
+    /*!
+    * Nanoseconds since first use in this process.
+    */
+    static uint64_t now() noexcept {
+        static const auto origin = std::chrono::steady_clock::now();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - origin).count());
+    }
+
+    static void record(TraceEvent event) {
+        Buffer& b = local();
+        std::lock_guard<std::mutex> lock(b.mtx);
+        b.events.push_back(std::move(event));
+    }
+
+    /*!
+    * Every recorded span, grouped by thread id (1-based, in order of first span).
+    */
+    template<typename F>
+    static void for_each(F&& f) {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        for (const auto& b : r.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(b->mtx);
+            for (const auto& e : b->events)
+                f(b->tid, e);
+        }
+    }
+
+    static std::size_t size() {
+        std::size_t n = 0;
+        for_each([&](uint32_t, const TraceEvent&) { ++n; });
+        return n;
+    }
+
+    static void clear() {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        for (const auto& b : r.buffers) {
+            std::lock_guard<std::mutex> buffer_lock(b->mtx);
+            b->events.clear();
+        }
+    }
+
+    /*!
+    * Complete (`"ph": "X"`) events, timestamps in microseconds.
+    */
+    static void write(std::ostream& out) {
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        bool first = true;
+        char ts[64];
+        for_each([&](uint32_t tid, const TraceEvent& e) {
+            std::snprintf(ts, sizeof(ts), "\"ts\": %.3f, \"dur\": %.3f", static_cast<double>(e.start_ns) * 1e-3,
+                          static_cast<double>(e.duration_ns) * 1e-3);
+            out << (first ? "\n" : ",\n") << "  {\"ph\": \"X\", \"pid\": 1, \"tid\": " << tid << ", " << ts << ", \"cat\": \"";
+            escaped(out, e.category);
+            out << "\", \"name\": \"";
+            escaped(out, e.name);
+            out << '"';
+            if (!e.detail.empty()) {
+                out << ", \"args\": {\"detail\": \"";
+                escaped(out, e.detail);
+                out << "\"}";
+            }
+            out << '}';
+            first = false;
+        });
+        out << (first ? "]}\n" : "\n]}\n");
+    }
+
+    static void write(const std::filesystem::path& path) {
+        std::ofstream fout(path);
+        if (!fout)
+            throw std::ios_base::failure("Failed to open trace file: " + path.string());
+        write(fout);
+    }
+};
+
+#if defined(TRTTL_TRACING)
+/*!
+* Scoped span - recorded into the calling thread's buffer when it ends.
+*/
+class TraceSpan {
+private:
+    std::string_view category;
+    std::string_view name;
+    std::string detail;
+    uint64_t start;
+
+public:
+    TraceSpan(std::string_view category, std::string_view name, std::string_view detail = {})
+        : category(category), name(name), detail(detail), start(Tracer::now()) {}
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan() {
+        try {
+            Tracer::record({category, name, std::move(detail), start, Tracer::now() - start});
+        } catch (...) {}
+    }
+};
+#else
+class TraceSpan {
+public:
+    constexpr TraceSpan(std::string_view, std::string_view, std::string_view = {}) noexcept {}
+};
+
+static_assert(std::is_empty_v<TraceSpan> && std::is_trivially_destructible_v<TraceSpan>);
+#endif
+
+} // trttl namespace
+#endif // TRACING_HPP
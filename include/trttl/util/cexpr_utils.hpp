@@ -2,29 +2,62 @@
 #define CEXPR_UTILS_HPP
 
 #include <type_traits>
+#include <string_view>
+#include <cstddef>
+#include <utility>
 
 namespace trttl {
     namespace cexpr_utils {
         /*!
-        * Returns last param.
+        * Pack element `I` tagged with its index - `pack` inherits one per element.
         */
-        template <typename... Ts>
-        struct last_rec {
-            static_assert(sizeof...(Ts) > 0, "Empty parameter pack! Cannot deduce the last type.");
+        template<std::size_t I, typename T>
+        struct indexed {
+            using type = T;
         };
 
-        template<typename T>
-        struct last_rec<T> {
-            using type = T; 
-        };
+        template<typename Is, typename... Ts>
+        struct pack;
 
-        template<typename T1, typename T2, typename... Ts>
-        struct last_rec<T1, T2, Ts...> {
-            using type = typename last_rec<T2, Ts...>::type;
-        };
+        template<std::size_t... Is, typename... Ts>
+        struct pack<std::index_sequence<Is...>, Ts...> : indexed<Is, Ts>... {};
 
+        template<std::size_t I, typename T>
+        indexed<I, T> select(const indexed<I, T>&);
+
+        /*!
+        * Returns `I`-th param - constant instantiation depth (overload resolution against indexed bases).
+        */
+        template<std::size_t I, typename... Ts>
+        requires (I < sizeof...(Ts))
+        using nth = typename decltype(select<I>(std::declval<const pack<std::index_sequence_for<Ts...>, Ts...>&>()))::type;
+
+        /*!
+        * Returns last param.
+        */
         template<typename... Ts>
-        using last = typename last_rec<Ts...>::type;
+        requires (sizeof...(Ts) > 0)
+        using last = nth<sizeof...(Ts) - 1, Ts...>;
+
+        /*!
+        * Compiler-specific spelling of type `T` (includes template arguments).
+        */
+        template <typename T>
+        constexpr std::string_view type_name() {
+            return __PRETTY_FUNCTION__;
+        }
+
+        /*!
+        * Unqualified name of `T` without template arguments (`trttl::LinearLayer<...>` -> `LinearLayer`).
+        */
+        template <typename T>
+        constexpr std::string_view short_type_name() {
+            std::string_view s = type_name<T>();
+            s.remove_prefix(s.find("T = ") + 4);
+            s = s.substr(0, s.find_first_of("<;]"));
+            const std::size_t scope = s.rfind("::");
+            return scope == std::string_view::npos ? s : s.substr(scope + 2);
+        }
 
         /*!
         * Converts enum to underlying type.
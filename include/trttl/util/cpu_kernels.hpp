@@ -0,0 +1,204 @@
+#ifndef CPU_KERNELS_HPP
+#define CPU_KERNELS_HPP
+
+#include "simd_utils.hpp"
+#include "trt_types.hpp"
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+namespace trttl {
+    namespace cpu_kernels {
+        /*!
+        * Single activation element/vector.
+        */
+        template<typename V, trt_types::ActivationType at>
+        typename V::reg activate(typename V::reg v) {
+            if constexpr (at == trt_types::ActivationType::kRELU) {
+                return V::max(v, V::set1(0.f));
+            } else if constexpr (at == trt_types::ActivationType::kSIGMOID) {
+                return V::div(V::set1(1.f), V::add(V::set1(1.f), V::exp(V::sub(V::set1(0.f), v))));
+            } else if constexpr (at == trt_types::ActivationType::kTANH) {
+                if constexpr (std::is_same_v<V, simd_utils::Scalar>)
+                    return std::tanh(v);
+                else
+                    return V::sub(V::div(V::set1(2.f), V::add(V::set1(1.f), V::exp(V::mul(V::set1(-2.f), v)))), V::set1(1.f));
+            } else {
+                static_assert(at == trt_types::ActivationType::kRELU, "Activation type not supported on CPU.");
+            }
+        }
+
+        /*!
+        * `linear` epilogue leaving outputs untouched.
+        */
+        struct NoEpilogue {
+            template<typename V>
+            static typename V::reg apply(typename V::reg v) { return v; }
+        };
+
+        /*!
+        * `linear` epilogue applying activation while an output row is still in cache.
+        */
+        template<trt_types::ActivationType at>
+        struct ActivationEpilogue {
+            template<typename V>
+            static typename V::reg apply(typename V::reg v) { return activate<V, at>(v); }
+        };
+
+        /*!
+        * Fully connected: `y[rows x N] = x[rows x K] * w[N x K]^T + b[N]` (row-major, PyTorch `nn.Linear` layout).
+        * Shapes are compile-time so loops fully specialize; `x` and `y` must not alias.
+        *
+        * @tparam V - `simd_utils` instruction set
+        * @tparam E - epilogue applied to outputs before returning
+        */
+        template<typename V, std::size_t rows, std::size_t K, std::size_t N, typename E = NoEpilogue>
+        void linear(const float* x, const float* w, const float* b, float* y) {
+            constexpr std::size_t W = V::width;
+            constexpr std::size_t body = K / W * W;
+            for (std::size_t r = 0; r < rows; ++r) {
+                const float* xr = x + r * K;
+                float* yr = y + r * N;
+                std::size_t n = 0;
+                if constexpr (W > 1 && body > 0) {
+                    for (; n + 4 <= N; n += 4) {                            // 4 outputs share each `x` load
+                        const float* w0 = w + n * K;
+                        typename V::reg a0 = V::set1(0.f), a1 = a0, a2 = a0, a3 = a0;
+                        for (std::size_t k = 0; k < body; k += W) {
+                            const typename V::reg xv = V::load(xr + k);
+                            a0 = V::fma(xv, V::load(w0 + k), a0);
+                            a1 = V::fma(xv, V::load(w0 + K + k), a1);
+                            a2 = V::fma(xv, V::load(w0 + 2 * K + k), a2);
+                            a3 = V::fma(xv, V::load(w0 + 3 * K + k), a3);
+                        }
+                        float s0 = V::hsum(a0), s1 = V::hsum(a1), s2 = V::hsum(a2), s3 = V::hsum(a3);
+                        for (std::size_t k = body; k < K; ++k) {
+                            s0 += xr[k] * w0[k];
+                            s1 += xr[k] * w0[K + k];
+                            s2 += xr[k] * w0[2 * K + k];
+                            s3 += xr[k] * w0[3 * K + k];
+                        }
+                        yr[n] = b[n] + s0;
+                        yr[n + 1] = b[n + 1] + s1;
+                        yr[n + 2] = b[n + 2] + s2;
+                        yr[n + 3] = b[n + 3] + s3;
+                    }
+                }
+                for (; n < N; ++n) {                                        // scalar reference / tail
+                    const float* wn = w + n * K;
+                    float s = 0.f;
+                    std::size_t k = 0;
+                    if constexpr (W > 1 && body > 0) {
+                        typename V::reg a = V::set1(0.f);
+                        for (; k < body; k += W)
+                            a = V::fma(V::load(xr + k), V::load(wn + k), a);
+                        s = V::hsum(a);
+                    }
+                    for (; k < K; ++k)
+                        s += xr[k] * wn[k];
+                    yr[n] = b[n] + s;
+                }
+                if constexpr (!std::is_same_v<E, NoEpilogue>) {
+                    n = 0;
+                    if constexpr (W > 1)
+                        for (; n + W <= N; n += W)
+                            V::store(yr + n, E::template apply<V>(V::load(yr + n)));
+                    for (; n < N; ++n)
+                        yr[n] = E::template apply<simd_utils::Scalar>(yr[n]);
+                }
+            }
+        }
+
+        /*!
+        * Elementwise activation over `n` floats - may run in place.
+        */
+        template<typename V, trt_types::ActivationType at>
+        void activation(const float* x, float* y, std::size_t n) {
+            std::size_t i = 0;
+            if constexpr (V::width > 1)
+                for (; i + V::width <= n; i += V::width)
+                    V::store(y + i, activate<V, at>(V::load(x + i)));
+            for (; i < n; ++i)
+                y[i] = activate<simd_utils::Scalar, at>(x[i]);
+        }
+
+        /*!
+        * Row-wise numerically stable softmax over `rows x cols` - may run in place.
+        */
+        template<typename V>
+        void softmax(const float* x, float* y, std::size_t rows, std::size_t cols) {
+            constexpr std::size_t W = V::width;
+            for (std::size_t r = 0; r < rows; ++r) {
+                const float* xr = x + r * cols;
+                float* yr = y + r * cols;
+
+                float m = xr[0];
+                std::size_t i = 0;
+                if constexpr (W > 1) {
+                    if (cols >= W) {
+                        typename V::reg vm = V::load(xr);
+                        for (i = W; i + W <= cols; i += W)
+                            vm = V::max(vm, V::load(xr + i));
+                        m = V::hmax(vm);
+                    }
+                }
+                for (; i < cols; ++i)
+                    m = std::max(m, xr[i]);
+
+                float s = 0.f;
+                i = 0;
+                if constexpr (W > 1) {
+                    typename V::reg vs = V::set1(0.f);
+                    const typename V::reg vmax = V::set1(m);
+                    for (; i + W <= cols; i += W) {
+                        const typename V::reg e = V::exp(V::sub(V::load(xr + i), vmax));
+                        V::store(yr + i, e);
+                        vs = V::add(vs, e);
+                    }
+                    s = V::hsum(vs);
+                }
+                for (; i < cols; ++i) {
+                    yr[i] = std::exp(xr[i] - m);
+                    s += yr[i];
+                }
+
+                const float inv = 1.f / s;
+                i = 0;
+                if constexpr (W > 1)
+                    for (; i + W <= cols; i += W)
+                        V::store(yr + i, V::mul(V::load(yr + i), V::set1(inv)));
+                for (; i < cols; ++i)
+                    yr[i] *= inv;
+            }
+        }
+
+        /*!
+        * Interleaved (HWC) u8 image of `pixels x channels` to planar (CHW) floats `x * scale[c] + bias[c]`.
+        * Each step loads `V::width` whole pixels contiguously and stores one register per plane.
+        */
+        template<typename V, std::size_t pixels, std::size_t channels>
+        void normalize_hwc(const uint8_t* src, float* dst, const float* scale, const float* bias) {
+            constexpr std::size_t body = pixels / V::width * V::width;
+            if constexpr (V::width > 1) {
+                typename V::reg vs[channels], vb[channels], x[channels];
+                for (std::size_t c = 0; c < channels; ++c) {
+                    vs[c] = V::set1(scale[c]);
+                    vb[c] = V::set1(bias[c]);
+                }
+                for (std::size_t i = 0; i < body; i += V::width) {
+                    V::template load_u8_planar<channels>(src + i * channels, x);
+                    [&]<std::size_t... Cs>(std::index_sequence<Cs...>) {
+                        (V::store(dst + Cs * pixels + i, V::fma(x[Cs], vs[Cs], vb[Cs])), ...);
+                    }(std::make_index_sequence<channels>{});
+                }
+            }
+            for (std::size_t i = V::width > 1 ? body : 0; i < pixels; ++i)
+                for (std::size_t c = 0; c < channels; ++c)
+                    dst[c * pixels + i] = simd_utils::Scalar::fma(static_cast<float>(src[i * channels + c]), scale[c], bias[c]);
+        }
+    } // cpu_kernels namespace
+} // trttl namespace
+#endif //CPU_KERNELS_HPP
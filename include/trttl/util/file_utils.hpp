@@ -0,0 +1,93 @@
+#ifndef FILE_UTILS_HPP
+#define FILE_UTILS_HPP
+
+#include <initializer_list>
+#include <filesystem>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <atomic>
+#include <string>
+#include <sys/file.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+namespace trttl {
+    namespace file_utils {
+        /*!
+        * Contiguous chunk of bytes to write.
+        */
+        struct Chunk {
+            const void* data;
+            std::size_t size;
+        };
+
+        /*!
+        * Writes chunks to a temp file next to `path`, fsyncs and renames it over `path`,
+        * so readers see either old or new content - never a partial file.
+        */
+        inline void atomic_write(const std::filesystem::path& path, std::initializer_list<Chunk> chunks) {
+            static std::atomic<uint64_t> counter{0};
+            auto tmp = path;
+            tmp += ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter.fetch_add(1));
+
+            const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0)
+                throw std::ios_base::failure("Failed to create file: " + tmp.string());
+            auto write_all = [fd](const void* p, std::size_t n) {
+                const auto* c = static_cast<const char*>(p);
+                while (n > 0) {
+                    const ssize_t w = ::write(fd, c, n);
+                    if (w <= 0)
+                        return false;
+                    c += w;
+                    n -= static_cast<std::size_t>(w);
+                }
+                return true;
+            };
+            bool ok = true;
+            for (const auto& c : chunks)
+                ok = ok && write_all(c.data, c.size);
+            ok = ok && ::fsync(fd) == 0;
+            ::close(fd);
+
+            std::error_code ec;
+            if (!ok) {
+                std::filesystem::remove(tmp, ec);
+                throw std::ios_base::failure("Failed to write file: " + tmp.string());
+            }
+            std::filesystem::rename(tmp, path);
+        }
+
+        /*!
+        * Exclusive advisory lock (`flock`) on `path`, created if missing - serializes processes (RAII).
+        */
+        class FileLock {
+        private:
+            int fd;
+
+        public:
+            explicit FileLock(const std::filesystem::path& path) {
+                fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                if (fd < 0)
+                    throw std::ios_base::failure("Failed to open lock file: " + path.string());
+                while (::flock(fd, LOCK_EX) != 0) {
+                    if (errno != EINTR) {
+                        ::close(fd);
+                        throw std::ios_base::failure("Failed to lock file: " + path.string());
+                    }
+                }
+            }
+
+            FileLock(const FileLock&) = delete;
+            FileLock& operator=(const FileLock&) = delete;
+
+            ~FileLock() {
+                ::flock(fd, LOCK_UN);
+                ::close(fd);
+            }
+        };
+    } // file_utils namespace
+} // trttl namespace
+#endif //FILE_UTILS_HPP
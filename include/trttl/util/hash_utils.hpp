@@ -0,0 +1,170 @@
+#ifndef HASH_UTILS_HPP
+#define HASH_UTILS_HPP
+
+#include "trt_types.hpp"
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace trttl {
+    namespace hash_utils {
+        /*!
+        * FNV-1a over string - usable in constant expressions.
+        */
+        constexpr uint64_t fnv1a(std::string_view s, uint64_t h = 14695981039346656037ull) {
+            for (char c : s) {
+                h ^= static_cast<uint8_t>(c);
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        /*!
+        * Avalanche finalizer (splitmix64).
+        */
+        constexpr uint64_t mix(uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ull;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebull;
+            x ^= x >> 31;
+            return x;
+        }
+
+        /*!
+        * Order-dependent combination of two hashes.
+        */
+        constexpr uint64_t combine(uint64_t seed, uint64_t v) {
+            return mix(seed ^ (v + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2)));
+        }
+
+        constexpr uint64_t hash_dims(const trt_types::Dims& d) {
+            uint64_t h = mix(static_cast<uint64_t>(d.nbDims));
+            for (auto i = 0; i < d.nbDims; ++i)
+                h = combine(h, static_cast<uint64_t>(static_cast<uint32_t>(d.d[i])));
+            return h;
+        }
+
+        /*!
+        * Fast non-cryptographic hash of a byte range (4-lane multiply-rotate, xxHash64 style).
+        */
+        inline uint64_t hash_bytes(const void* data, std::size_t len, uint64_t seed = 0) {
+            constexpr uint64_t p1 = 0x9e3779b185ebca87ull;
+            constexpr uint64_t p2 = 0xc2b2ae3d27d4eb4full;
+            auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+            auto round = [&](uint64_t acc, uint64_t in) { return rotl(acc + in * p2, 31) * p1; };
+            auto load = [](const unsigned char* p) { uint64_t v; std::memcpy(&v, p, 8); return v; };
+
+            const auto* p = static_cast<const unsigned char*>(data);
+            const auto* end = p + len;
+            uint64_t h;
+            if (len >= 32) {
+                uint64_t v1 = seed + p1 + p2, v2 = seed + p2, v3 = seed, v4 = seed - p1;
+                for (; p + 32 <= end; p += 32) {
+                    v1 = round(v1, load(p));
+                    v2 = round(v2, load(p + 8));
+                    v3 = round(v3, load(p + 16));
+                    v4 = round(v4, load(p + 24));
+                }
+                h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+                h = (h ^ round(0, v1)) * p1;
+                h = (h ^ round(0, v2)) * p1;
+                h = (h ^ round(0, v3)) * p1;
+                h = (h ^ round(0, v4)) * p1;
+            } else {
+                h = seed + 0x165667b19e3779f9ull;
+            }
+            h += len;
+            for (; p + 8 <= end; p += 8)
+                h = rotl(h ^ round(0, load(p)), 27) * p1 + 0x85ebca77c2b2ae63ull;
+            for (; p < end; ++p)
+                h = rotl(h ^ (*p * 0x27d4eb2f165667c5ull), 11) * p1;
+            return mix(h);
+        }
+
+        /*!
+        * Content hash of large blobs (weights) - xxh3-style 64-byte stripes over 8 u64 lanes.
+        * Each lane adds the input to its neighbour and a 32x32->64 product of the keyed input to itself,
+        * lanes are scrambled every 1 KiB. AVX-512/AVX2 take a stripe in one/two registers,
+        * every path returns the same value. Blobs shorter than a stripe go to `hash_bytes`.
+        */
+        inline uint64_t hash_blob(const void* data, std::size_t len, uint64_t seed = 0) {
+            if (len < 64)
+                return hash_bytes(data, len, seed);
+
+            constexpr uint64_t prime32 = 0x9e3779b1ull;
+            constexpr std::size_t block = 16;                   // stripes between scrambles
+            alignas(64) uint64_t acc[8] = {0xc2b2ae3dull, 0x9e3779b185ebca87ull, 0xc2b2ae3d27d4eb4full, 0x165667b19e3779f9ull,
+                                           0x85ebca77c2b2ae63ull, 0x85ebca77ull, 0x27d4eb2f165667c5ull, 0x9e3779b1ull};
+            alignas(64) uint64_t key[8] = {0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull,
+                                           0x78e5c0cc4ee679cbull, 0x2172ffcc7dd05a82ull, 0x8e2443f7744608b8ull, 0x4c263a81e69035e0ull};
+            for (auto& k : key)
+                k += seed;
+
+            const auto* p = static_cast<const unsigned char*>(data);
+            const std::size_t stripes = len / 64;
+#if defined(__AVX512F__)
+            __m512i a = _mm512_load_si512(acc);
+            const __m512i k = _mm512_load_si512(key);
+            const __m512i m = _mm512_set1_epi64(static_cast<long long>(prime32));
+            for (std::size_t s = 0; s < stripes; ++s) {
+                const __m512i d = _mm512_loadu_si512(p + s * 64);
+                const __m512i dk = _mm512_xor_si512(d, k);
+                a = _mm512_add_epi64(a, _mm512_mul_epu32(dk, _mm512_srli_epi64(dk, 32)));
+                a = _mm512_add_epi64(a, _mm512_shuffle_epi32(d, _MM_PERM_BADC));
+                if ((s + 1) % block == 0) {
+                    a = _mm512_xor_si512(_mm512_xor_si512(a, _mm512_srli_epi64(a, 47)), k);
+                    a = _mm512_add_epi64(_mm512_mul_epu32(a, m), _mm512_slli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), m), 32));
+                }
+            }
+            _mm512_store_si512(acc, a);
+#elif defined(__AVX2__)
+            __m256i a[2] = {_mm256_load_si256(reinterpret_cast<const __m256i*>(acc)),
+                            _mm256_load_si256(reinterpret_cast<const __m256i*>(acc + 4))};
+            const __m256i k[2] = {_mm256_load_si256(reinterpret_cast<const __m256i*>(key)),
+                                  _mm256_load_si256(reinterpret_cast<const __m256i*>(key + 4))};
+            const __m256i m = _mm256_set1_epi64x(static_cast<long long>(prime32));
+            for (std::size_t s = 0; s < stripes; ++s) {
+                for (int j = 0; j < 2; ++j) {
+                    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + s * 64 + j * 32));
+                    const __m256i dk = _mm256_xor_si256(d, k[j]);
+                    a[j] = _mm256_add_epi64(a[j], _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32)));
+                    a[j] = _mm256_add_epi64(a[j], _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)));
+                }
+                if ((s + 1) % block == 0) {
+                    for (int j = 0; j < 2; ++j) {
+                        a[j] = _mm256_xor_si256(_mm256_xor_si256(a[j], _mm256_srli_epi64(a[j], 47)), k[j]);
+                        a[j] = _mm256_add_epi64(_mm256_mul_epu32(a[j], m),
+                                                _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a[j], 32), m), 32));
+                    }
+                }
+            }
+            _mm256_store_si256(reinterpret_cast<__m256i*>(acc), a[0]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(acc + 4), a[1]);
+#else
+            for (std::size_t s = 0; s < stripes; ++s) {
+                uint64_t d[8];
+                std::memcpy(d, p + s * 64, 64);
+                for (int i = 0; i < 8; ++i) {
+                    const uint64_t dk = d[i] ^ key[i];
+                    acc[i ^ 1] += d[i];
+                    acc[i] += (dk & 0xffffffffull) * (dk >> 32);
+                }
+                if ((s + 1) % block == 0)
+                    for (int i = 0; i < 8; ++i)
+                        acc[i] = (acc[i] ^ (acc[i] >> 47) ^ key[i]) * prime32;
+            }
+#endif
+            uint64_t h = mix(seed + len);
+            for (auto v : acc)
+                h = combine(h, v);
+            const std::size_t done = stripes * 64;
+            return done == len ? h : hash_bytes(p + done, len - done, h);
+        }
+    } // hash_utils namespace
+} // trttl namespace
+#endif //HASH_UTILS_HPP
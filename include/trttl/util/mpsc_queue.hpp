@@ -0,0 +1,108 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <array>
+#include <new>
+
+namespace trttl {
+    namespace conc_utils {
+        /*!
+        * Cache line size used for padding shared atomics.
+        */
+        inline constexpr std::size_t cache_line = 64;
+
+        /*!
+        * Bounded lock-free ring buffer (Vyukov's sequence-number scheme).
+        * Many producers may push concurrently. Pop is also safe from several threads,
+        * which lets producers evict the oldest element when the buffer is full.
+        *
+        * @tparam T - trivially copyable element type
+        * @tparam capacity - number of slots, must be a power of two
+        */
+        template<typename T, std::size_t capacity>
+        requires (capacity >= 2 && (capacity & (capacity - 1)) == 0 && std::is_trivially_copyable_v<T>)
+        class MPSCQueue {
+        private:
+            static constexpr std::size_t mask = capacity - 1;
+
+            struct alignas(cache_line) Slot {
+                std::atomic<std::size_t> seq;
+                T value;
+            };
+
+            std::array<Slot, capacity> slots;                       /*!< Ring storage.*/
+            alignas(cache_line) std::atomic<std::size_t> head{0};   /*!< Next slot to pop.*/
+            alignas(cache_line) std::atomic<std::size_t> tail{0};   /*!< Next slot to push.*/
+
+        public:
+            MPSCQueue() {
+                for (std::size_t i = 0; i < capacity; ++i)
+                    slots[i].seq.store(i, std::memory_order_relaxed);
+            }
+
+            MPSCQueue(const MPSCQueue&) = delete;
+            MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+            /*!
+            * Pushes a copy of `v`, returns false if the queue is full.
+            */
+            bool try_push(const T& v) noexcept {
+                std::size_t pos = tail.load(std::memory_order_relaxed);
+                for (;;) {
+                    Slot& s = slots[pos & mask];
+                    const std::size_t seq = s.seq.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                    if (diff == 0) {
+                        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            s.value = v;
+                            s.seq.store(pos + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = tail.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /*!
+            * Pops the oldest element into `out`, returns false if the queue is empty.
+            */
+            bool try_pop(T& out) noexcept {
+                std::size_t pos = head.load(std::memory_order_relaxed);
+                for (;;) {
+                    Slot& s = slots[pos & mask];
+                    const std::size_t seq = s.seq.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                    if (diff == 0) {
+                        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            out = s.value;
+                            s.seq.store(pos + capacity, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = head.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /*!
+            * Approximate emptiness check - exact only when producers are quiescent.
+            */
+            bool empty() const noexcept {
+                const std::size_t pos = head.load(std::memory_order_acquire);
+                return slots[pos & mask].seq.load(std::memory_order_acquire) != pos + 1;
+            }
+
+            static constexpr std::size_t size = capacity;
+        };
+    } // conc_utils namespace
+} // trttl namespace
+#endif //MPSC_QUEUE_HPP
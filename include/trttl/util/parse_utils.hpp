@@ -0,0 +1,163 @@
+#ifndef PARSE_UTILS_HPP
+#define PARSE_UTILS_HPP
+
+#include <stdexcept>
+#include <string_view>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cctype>
+
+namespace trttl {
+    namespace parse_utils {
+        /*!
+        * Minimal cursor over JSON / Python-literal text - just enough for weight file headers.
+        * Throws `std::runtime_error` on malformed input.
+        */
+        class Cursor {
+        private:
+            std::string_view text;
+            std::size_t pos = 0;
+
+        public:
+            explicit Cursor(std::string_view t) : text(t) {}
+
+            [[noreturn]] void fail(const char* what) const {
+                throw std::runtime_error(std::string("Malformed header: ") + what +
+                                         " at offset " + std::to_string(pos));
+            }
+
+            void skip_ws() {
+                while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+                    ++pos;
+            }
+
+            char peek() {
+                skip_ws();
+                return pos < text.size() ? text[pos] : '\0';
+            }
+
+            bool consume(char c) {
+                if (peek() != c)
+                    return false;
+                ++pos;
+                return true;
+            }
+
+            void expect(char c) {
+                if (!consume(c))
+                    fail("unexpected character");
+            }
+
+            /*!
+            * Parses string quoted with `"` or `'` (escapes are kept verbatim except `\"`).
+            */
+            std::string string() {
+                const char q = peek();
+                if (q != '"' && q != '\'')
+                    fail("expected string");
+                ++pos;
+                std::string r;
+                while (pos < text.size() && text[pos] != q) {
+                    if (text[pos] == '\\' && pos + 1 < text.size())
+                        ++pos;
+                    r += text[pos++];
+                }
+                if (pos >= text.size())
+                    fail("unterminated string");
+                ++pos;
+                return r;
+            }
+
+            int64_t integer() {
+                skip_ws();
+                const std::size_t start = pos;
+                if (pos < text.size() && text[pos] == '-')
+                    ++pos;
+                while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos])))
+                    ++pos;
+                if (start == pos)
+                    fail("expected integer");
+                return std::stoll(std::string(text.substr(start, pos - start)));
+            }
+
+            /*!
+            * Parses `[a, b, ...]` or `(a, b, ...)` list of integers, trailing comma allowed.
+            */
+            std::vector<int64_t> int_list() {
+                const char open = peek();
+                if (open != '[' && open != '(')
+                    fail("expected list");
+                ++pos;
+                const char close = open == '[' ? ']' : ')';
+                std::vector<int64_t> r;
+                while (!consume(close)) {
+                    r.push_back(integer());
+                    if (!consume(','))
+                        if (peek() != close)
+                            fail("expected , in list");
+                }
+                return r;
+            }
+
+            /*!
+            * Identifier-like token (`true`, `False`, `null`, ...).
+            */
+            std::string word() {
+                skip_ws();
+                const std::size_t start = pos;
+                while (pos < text.size() && std::isalpha(static_cast<unsigned char>(text[pos])))
+                    ++pos;
+                if (start == pos)
+                    fail("expected literal");
+                return std::string(text.substr(start, pos - start));
+            }
+
+            /*!
+            * Skips any value.
+            */
+            void skip_value() {
+                const char c = peek();
+                if (c == '"' || c == '\'') {
+                    string();
+                } else if (c == '{' || c == '[' || c == '(') {
+                    const char close = c == '{' ? '}' : (c == '[' ? ']' : ')');
+                    ++pos;
+                    while (!consume(close)) {
+                        skip_value();
+                        if (c == '{') {
+                            expect(':');
+                            skip_value();
+                        }
+                        consume(',');
+                    }
+                } else if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+                    ++pos;
+                    while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) ||
+                           text[pos] == '.' || text[pos] == '+' || text[pos] == '-'))
+                        ++pos;
+                } else {
+                    word();
+                }
+            }
+
+            /*!
+            * Iterates `{key: value, ...}` calling `f(key)` positioned at each value;
+            * `f` must consume the value.
+            */
+            template<typename F>
+            void object(F&& f) {
+                expect('{');
+                while (!consume('}')) {
+                    const std::string key = string();
+                    expect(':');
+                    f(key);
+                    if (!consume(','))
+                        if (peek() != '}')
+                            fail("expected , in object");
+                }
+            }
+        };
+    } // parse_utils namespace
+} // trttl namespace
+#endif //PARSE_UTILS_HPP
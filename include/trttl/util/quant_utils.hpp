@@ -0,0 +1,73 @@
+#ifndef QUANT_UTILS_HPP
+#define QUANT_UTILS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <cmath>
+#if defined(__AVX512F__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace trttl {
+    namespace quant_utils {
+        /*!
+        * IEEE fp32 -> fp16, round to nearest even (overflow -> inf, NaN -> quiet NaN).
+        */
+        inline uint16_t fp32_to_fp16(float f) {
+            const float scale_to_inf = 0x1.0p+112f;
+            const float scale_to_zero = 0x1.0p-110f;
+            float base = (std::fabs(f) * scale_to_inf) * scale_to_zero;
+
+            const uint32_t w = std::bit_cast<uint32_t>(f);
+            const uint32_t shl1_w = w + w;
+            const uint32_t sign = w & 0x80000000u;
+            uint32_t bias = std::max(shl1_w & 0xFF000000u, 0x71000000u);
+            base = std::bit_cast<float>((bias >> 1) + 0x07800000u) + base;
+
+            const uint32_t bits = std::bit_cast<uint32_t>(base);
+            const uint32_t nonsign = ((bits >> 13) & 0x00007C00u) + (bits & 0x00000FFFu);
+            return static_cast<uint16_t>((sign >> 16) | (shl1_w > 0xFF000000u ? 0x7E00u : nonsign));
+        }
+
+        inline float fp16_to_fp32(uint16_t h) {
+            const uint32_t w = static_cast<uint32_t>(h) << 16;
+            const uint32_t sign = w & 0x80000000u;
+            const uint32_t two_w = w + w;
+            const float normalized = std::bit_cast<float>((two_w >> 4) + (0xE0u << 23)) * 0x1.0p-112f;
+            const float denormalized = std::bit_cast<float>((two_w >> 17) | (126u << 23)) - 0.5f;
+            return std::bit_cast<float>(sign | std::bit_cast<uint32_t>(two_w < (1u << 27) ? denormalized : normalized));
+        }
+
+        /*!
+        * Converts `n` floats to fp16 (F16C / AVX-512 when enabled, scalar tail).
+        */
+        inline void to_fp16(const float* src, uint16_t* dst, std::size_t n) {
+            std::size_t i = 0;
+#if defined(__AVX512F__)
+            for (; i + 16 <= n; i += 16)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                                    _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#endif
+#if defined(__F16C__)
+            for (; i + 8 <= n; i += 8)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                                 _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+#endif
+            for (; i < n; ++i)
+                dst[i] = fp32_to_fp16(src[i]);
+        }
+
+        inline void from_fp16(const uint16_t* src, float* dst, std::size_t n) {
+            std::size_t i = 0;
+#if defined(__F16C__)
+            for (; i + 8 <= n; i += 8)
+                _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+#endif
+            for (; i < n; ++i)
+                dst[i] = fp16_to_fp32(src[i]);
+        }
+    } // quant_utils namespace
+} // trttl namespace
+#endif //QUANT_UTILS_HPP
@@ -0,0 +1,224 @@
+#ifndef SIMD_UTILS_HPP
+#define SIMD_UTILS_HPP
+
+#include <algorithm>
+#include <utility>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace trttl {
+    namespace simd_utils {
+        /*!
+        * Where lane `i` of channel `c` comes from when `W` pixels of `C` interleaved channels are loaded
+        * as `C` consecutive registers - register `source[c][i]`, lane `index[c][i]`.
+        */
+        template<std::size_t C, std::size_t W>
+        struct PlanarLanes {
+            std::array<std::array<int32_t, W>, C> source;
+            std::array<std::array<int32_t, W>, C> index;
+        };
+
+        template<std::size_t C, std::size_t W>
+        constexpr PlanarLanes<C, W> planar_lanes() {
+            PlanarLanes<C, W> r{};
+            for (std::size_t c = 0; c < C; ++c)
+                for (std::size_t i = 0; i < W; ++i) {
+                    r.source[c][i] = static_cast<int32_t>((i * C + c) / W);
+                    r.index[c][i] = static_cast<int32_t>((i * C + c) % W);
+                }
+            return r;
+        }
+
+        /*!
+        * Portable scalar "vector" of width 1 - reference path and loop tails.
+        */
+        struct Scalar {
+            using reg = float;
+            static constexpr std::size_t width = 1;
+            static constexpr const char* name = "scalar";
+
+            static reg load(const float* p) { return *p; }
+            static reg load_u8(const uint8_t* p) { return static_cast<float>(*p); }
+
+            template<std::size_t C>
+            static void load_u8_planar(const uint8_t* p, reg (&out)[C]) {
+                for (std::size_t c = 0; c < C; ++c)
+                    out[c] = static_cast<float>(p[c]);
+            }
+            static void store(float* p, reg v) { *p = v; }
+            static reg set1(float v) { return v; }
+            static reg add(reg a, reg b) { return a + b; }
+            static reg sub(reg a, reg b) { return a - b; }
+            static reg mul(reg a, reg b) { return a * b; }
+            static reg div(reg a, reg b) { return a / b; }
+            static reg fma(reg a, reg b, reg c) { return a * b + c; }
+            static reg max(reg a, reg b) { return std::max(a, b); }
+            static float hmax(reg v) { return v; }
+            static float hsum(reg v) { return v; }
+            static reg exp(reg v) { return std::exp(v); }
+        };
+
+#if defined(__AVX2__) && defined(__FMA__)
+        /*!
+        * 8-wide AVX2/FMA.
+        */
+        struct Avx2 {
+            using reg = __m256;
+            static constexpr std::size_t width = 8;
+            static constexpr const char* name = "avx2";
+
+            static reg load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+
+            static reg load_u8(const uint8_t* p) {
+                return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+            }
+
+            /*!
+            * `width` pixels of `C` interleaved u8 channels to one float register per channel -
+            * contiguous loads, then a permute and blend per source register.
+            */
+            template<std::size_t C>
+            static void load_u8_planar(const uint8_t* p, reg (&out)[C]) {
+                static constexpr auto lanes = planar_lanes<C, width>();
+                [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+                    const reg r[] = {load_u8(p + Ks * width)...};
+                    auto channel = [&](std::size_t c) {
+                        const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.index[c].data()));
+                        const __m256i source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.source[c].data()));
+                        reg v = _mm256_permutevar8x32_ps(r[0], index);
+                        ((v = Ks == 0 ? v : _mm256_blendv_ps(v, _mm256_permutevar8x32_ps(r[Ks], index),
+                                                             _mm256_castsi256_ps(_mm256_cmpeq_epi32(source, _mm256_set1_epi32(Ks))))), ...);
+                        return v;
+                    };
+                    ((out[Ks] = channel(Ks)), ...);
+                }(std::make_index_sequence<C>{});
+            }
+
+            static reg set1(float v) { return _mm256_set1_ps(v); }
+            static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+            static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+            static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+            static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+            static reg fma(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+            static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+
+            static float hmax(reg v) {
+                __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+                m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+                return _mm_cvtss_f32(m);
+            }
+
+            static float hsum(reg v) {
+                __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+                s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+                return _mm_cvtss_f32(s);
+            }
+
+            /*!
+            * Cephes-style expf, ~1 ulp in [-87, 88].
+            */
+            static reg exp(reg x) {
+                x = _mm256_min_ps(_mm256_max_ps(x, set1(-87.3365f)), set1(88.3762f));
+                const reg n = _mm256_round_ps(mul(x, set1(1.44269504088896341f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                x = fma(n, set1(-0.693359375f), x);
+                x = fma(n, set1(2.12194440e-4f), x);
+                reg y = set1(1.9875691500e-4f);
+                y = fma(y, x, set1(1.3981999507e-3f));
+                y = fma(y, x, set1(8.3334519073e-3f));
+                y = fma(y, x, set1(4.1665795894e-2f));
+                y = fma(y, x, set1(1.6666665459e-1f));
+                y = fma(y, x, set1(5.0000001201e-1f));
+                y = fma(y, mul(x, x), add(x, set1(1.f)));
+                const __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+                return mul(y, _mm256_castsi256_ps(e));
+            }
+        };
+#endif
+
+#if defined(__AVX512F__)
+        /*!
+        * 16-wide AVX-512F.
+        */
+        struct Avx512 {
+            using reg = __m512;
+            static constexpr std::size_t width = 16;
+            static constexpr const char* name = "avx512";
+
+            static reg load(const float* p) { return _mm512_loadu_ps(p); }
+            static void store(float* p, reg v) { _mm512_storeu_ps(p, v); }
+
+            static reg load_u8(const uint8_t* p) {
+                return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+            }
+
+            /*!
+            * `width` pixels of `C` interleaved u8 channels to one float register per channel -
+            * contiguous loads, then one masked permute per source register.
+            */
+            template<std::size_t C>
+            static void load_u8_planar(const uint8_t* p, reg (&out)[C]) {
+                static constexpr auto lanes = planar_lanes<C, width>();
+                [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+                    const reg r[] = {load_u8(p + Ks * width)...};
+                    auto channel = [&](std::size_t c) {
+                        const __m512i index = _mm512_loadu_si512(lanes.index[c].data());
+                        const __m512i source = _mm512_loadu_si512(lanes.source[c].data());
+                        reg v = _mm512_permutexvar_ps(index, r[0]);
+                        ((v = Ks == 0 ? v : _mm512_mask_permutexvar_ps(v, _mm512_cmpeq_epi32_mask(source, _mm512_set1_epi32(Ks)), index, r[Ks])), ...);
+                        return v;
+                    };
+                    ((out[Ks] = channel(Ks)), ...);
+                }(std::make_index_sequence<C>{});
+            }
+
+            static reg set1(float v) { return _mm512_set1_ps(v); }
+            static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+            static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+            static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+            static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+            static reg fma(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+            static reg max(reg a, reg b) { return _mm512_max_ps(a, b); }
+            static float hmax(reg v) { return _mm512_reduce_max_ps(v); }
+            static float hsum(reg v) { return _mm512_reduce_add_ps(v); }
+
+            /*!
+            * Cephes-style expf, ~1 ulp in [-87, 88].
+            */
+            static reg exp(reg x) {
+                x = _mm512_min_ps(_mm512_max_ps(x, set1(-87.3365f)), set1(88.3762f));
+                const reg n = _mm512_roundscale_ps(mul(x, set1(1.44269504088896341f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                x = fma(n, set1(-0.693359375f), x);
+                x = fma(n, set1(2.12194440e-4f), x);
+                reg y = set1(1.9875691500e-4f);
+                y = fma(y, x, set1(1.3981999507e-3f));
+                y = fma(y, x, set1(8.3334519073e-3f));
+                y = fma(y, x, set1(4.1665795894e-2f));
+                y = fma(y, x, set1(1.6666665459e-1f));
+                y = fma(y, x, set1(5.0000001201e-1f));
+                y = fma(y, mul(x, x), add(x, set1(1.f)));
+                return _mm512_scalef_ps(y, n);
+            }
+        };
+#endif
+
+        /*!
+        * Widest instruction set enabled at compile time (`-mavx2 -mfma`, `-mavx512f`, `-march=native`).
+        */
+#if defined(__AVX512F__)
+        using Native = Avx512;
+#elif defined(__AVX2__) && defined(__FMA__)
+        using Native = Avx2;
+#else
+        using Native = Scalar;
+#endif
+    } // simd_utils namespace
+} // trttl namespace
+#endif //SIMD_UTILS_HPP
@@ -26,12 +26,26 @@ namespace trttl {
         return (lhs.nbDims == rhs.nbDims) && std::ranges::equal(lhs.d, rhs.d);
     }
 
-    int32_t dimVolume(const trt_types::Dims& dim) {
+    constexpr int32_t dimVolume(const trt_types::Dims& dim) {
         int32_t r = 1;
         for(auto i = 0; i < dim.nbDims; ++i)
             r *= dim.d[i];
         return r;
     }
 
+    /*!
+    * Row-major (contiguous) element strides of `dim`.
+    */
+    constexpr trt_types::Dims dimStrides(const trt_types::Dims& dim) {
+        trt_types::Dims s{};
+        s.nbDims = dim.nbDims;
+        int32_t r = 1;
+        for(auto i = dim.nbDims - 1; i >= 0; --i) {
+            s.d[i] = r;
+            r *= dim.d[i];
+        }
+        return s;
+    }
+
 } // trttl namespace
 #endif //TRT_TYPES_HPP
\ No newline at end of file
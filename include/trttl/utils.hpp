@@ -1,19 +1,35 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "util/hash_utils.hpp"
 #include "util/trt_types.hpp"
+#include "build_policy.hpp"
+#include "timing_cache.hpp"
+#include "plan_cache.hpp"
+#include "tracing.hpp"
 #include "modules.hpp"
+#include "weights.hpp"
 #include <NvInfer.h>
+#include <stdexcept>
 #include <algorithm>
+#include <utility>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace trttl {
 
 /*!
 * Utility wrapper around the process of creation and serialization of NNs.
+* Builder config (`configJson()`) is recorded with the plan only when serializing through a `PlanCache`
+* (read it back with `PlanCache::config()`); plain `serialize()` returns engine bytes alone.
+*
+* Parameters with equal contents are always stored (and added as constants) once per network;
+* `BuildPolicy::intern_weights` extends that to every other interning network of the process.
+*
+* @tparam policy - builder settings (`build_policies::dev`, `build_policies::prod` or custom)
 */
-template<DerivedFromModule M>
+template<DerivedFromModule M, BuildPolicy policy = build_policies::standard>
 class Network {
 private:
     M module;
@@ -22,19 +38,61 @@ private:
     trt_types::BuilderConf* config;
     trt_types::Network* network;
 
+    TimingCache* timing_cache = nullptr;
+    TimingCache::Attached timing;
+
+    /*!
+    * Module input shape with leading batch dim.
+    */
+    static trt_types::Dims inputDims(int32_t batch) {
+        trt_types::Dims in_dims{};
+        in_dims.nbDims = M::in_shape.nbDims+1;
+        in_dims.d[0] = batch;
+        for (auto i = 0; i < M::in_shape.nbDims; ++i)
+            in_dims.d[i+1] = M::in_shape.d[i];
+        return in_dims;
+    }
+
     void build(nvinfer1::ILogger &logger) {
+        TraceSpan span("define", "Network::build");
+        {
+            TraceSpan intern_span("weights", "Network::intern");
+            WeightRegistry local;                           // equal blobs become one constant within this network
+            module.intern(policy.intern_weights ? WeightRegistry::global() : local);
+        }
+        trt_types::Tensor* input = configure(logger);
+        trt_types::Tensor* output_tensor = module.addToNetwork(network, input);
+        network->markOutput(*output_tensor);
+    }
+
+    /*!
+    * Creates builder, config and optimization profile - returns network input.
+    */
+    trt_types::Tensor* configure(nvinfer1::ILogger &logger) {
+        TraceSpan span("config", "Network::configure");
         builder = nvinfer1::createInferBuilder(logger);
         config = builder->createBuilderConfig();
+        policy.apply(*config);
         network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
-        trt_types::Dims in_dims;
-        in_dims.nbDims = module.in_shape.nbDims+1;
-        in_dims.d[0] = module.batch_size;
-        for (auto i = 0; i < module.in_shape.nbDims; ++i)
-            in_dims.d[i+1] = module.in_shape.d[i];
-        auto input = network->addInput("input", trt_types::DataType::kFLOAT, in_dims);
+        constexpr BatchSize range = M::batch_range;
+        auto input = network->addInput("input", trt_types::DataType::kFLOAT, inputDims(range.dynamic() ? -1 : range.max));
+        if constexpr (range.dynamic()) {
+            auto profile = builder->createOptimizationProfile();
+            profile->setDimensions("input", nvinfer1::OptProfileSelector::kMIN, inputDims(range.min));
+            profile->setDimensions("input", nvinfer1::OptProfileSelector::kOPT, inputDims(range.opt));
+            profile->setDimensions("input", nvinfer1::OptProfileSelector::kMAX, inputDims(range.max));
+            config->addOptimizationProfile(profile);
+            if constexpr (M::data_type == trt_types::DataType::kINT8)
+                config->setCalibrationProfile(profile);
+        }
 
-        trt_types::Tensor* output_tensor = module.addToNetwork(network, input);
-        network->markOutput(*output_tensor);
+        if constexpr (M::data_type == trt_types::DataType::kHALF) {
+            config->setFlag(nvinfer1::BuilderFlag::kFP16);
+        } else if constexpr (M::data_type == trt_types::DataType::kINT8) {
+            config->setFlag(nvinfer1::BuilderFlag::kINT8);
+            config->setFlag(nvinfer1::BuilderFlag::kFP16);      // fallback for layers without INT8 kernels
+        }
+        return input;
     }
 
 public: 
@@ -42,7 +100,18 @@ public:
         build(log);
     }
 
-    Network(nvinfer1::ILogger& log, M m) : module(m) {
+    Network(nvinfer1::ILogger& log, M m) : module(std::move(m)) {
+        build(log);
+    }
+
+    /*!
+    * Binds module parameters to checkpoint tensors (mapped, zero-copy) before building.
+    */
+    Network(nvinfer1::ILogger& log, M m, const Checkpoint& ckpt, const std::string& name = "") : module(std::move(m)) {
+        {
+            TraceSpan span("weights", "Network::bind", name);
+            module.bind(ckpt, name);
+        }
         build(log);
     }
 
@@ -52,10 +121,107 @@ public:
         delete builder;
     }
 
+    /*!
+    * Calibrator for kINT8 modules - must outlive `serialize()`.
+    * Plan keys don't cover calibration data, use a separate `PlanCache` per calibration set.
+    */
+    void setCalibrator(nvinfer1::IInt8Calibrator* calibrator) {
+        config->setInt8Calibrator(calibrator);
+    }
+
+    /*!
+    * Timing cache loaded before and merged back after each `serialize()` - must outlive it.
+    * One cache can be shared by any number of networks and processes.
+    */
+    void setTimingCache(TimingCache* cache) {
+        timing_cache = cache;
+    }
+
+    /*!
+    * Builder config for further tuning before `serialize()`.
+    */
+    trt_types::BuilderConf* builderConfig() noexcept {
+        return config;
+    }
+
+    /*!
+    * Network definition for inspection or further layers before `serialize()`.
+    */
+    trt_types::Network* definition() noexcept {
+        return network;
+    }
+
+    /*!
+    * Builds engine bytes - callers keeping the plan elsewhere should store `configJson()` next to it.
+    */
     std::unique_ptr<trt_types::Memory> serialize() {
-        std::unique_ptr<trt_types::Memory> buffer(builder->buildSerializedNetwork(*network, *config));
+        if (timing_cache) {
+            TraceSpan span("config", "TimingCache::attach");
+            timing = timing_cache->attach(*config);
+        }
+        std::unique_ptr<trt_types::Memory> buffer;
+        {
+            TraceSpan span("build", "IBuilder::buildSerializedNetwork");
+            buffer.reset(builder->buildSerializedNetwork(*network, *config));
+        }
+        if (timing_cache && buffer) {
+            TraceSpan span("serialize", "TimingCache::save");
+            timing_cache->save(*config, timing);
+        }
         return buffer;
     }
+
+    /*!
+    * Plan cache key - architecture fingerprint combined with weights hash and build policy.
+    * Static form allows probing the cache before constructing `Network` at all.
+    */
+    static uint64_t planKey(const M& m) {
+        return hash_utils::combine(hash_utils::combine(M::fingerprint(), m.weightsHash()), policy.hash());
+    }
+
+    uint64_t planKey() const {
+        return planKey(module);
+    }
+
+    /*!
+    * Effective builder config as JSON (`describeConfig()`).
+    */
+    std::string configJson() {
+        return describeConfig(*config, policy.name);
+    }
+
+    /*!
+    * Serializes through `cache` - on hit the builder is not invoked. New entries record `configJson()`.
+    * The network is already defined by then, prefer the static overload when nothing needs `builderConfig()`.
+    */
+    Plan serialize(PlanCache& cache) {
+        return cache.getOrBuild(planKey(), [this] { return serialize(); }, configJson());
+    }
+
+    /*!
+    * Probes `cache` before constructing `Network` - a hit creates no builder, defines no network and
+    * hashes weights once. On a miss builds and stores the plan like `serialize(cache)`.
+    */
+    static Plan serialize(nvinfer1::ILogger& log, M m, PlanCache& cache) {
+        const uint64_t key = planKey(m);
+        if (auto plan = cache.get(key))
+            return std::move(*plan);
+        Network network(log, std::move(m));
+        return network.store(cache, key);
+    }
+
+    /*!
+    * Builds and stores the plan under `key` (`planKey()` computed before construction) - no cache lookup.
+    */
+    Plan store(PlanCache& cache, uint64_t key) {
+        auto memory = serialize();
+        if (!memory)
+            throw std::runtime_error("Engine build failed.");
+        const auto* p = static_cast<const char*>(memory->data());
+        Plan plan(p, p + memory->size());
+        cache.put(key, plan.data(), plan.size(), configJson());
+        return plan;
+    }
 };
 
 } // trttl namespace
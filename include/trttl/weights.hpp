@@ -0,0 +1,533 @@
+#ifndef WEIGHTS_HPP
+#define WEIGHTS_HPP
+
+#include "util/parse_utils.hpp"
+#include "util/quant_utils.hpp"
+#include "util/hash_utils.hpp"
+#include "util/trt_types.hpp"
+#include "tracing.hpp"
+#include <NvInfer.h>
+#include <unordered_map>
+#include <string_view>
+#include <algorithm>
+#include <stdexcept>
+#include <optional>
+#include <atomic>
+#include <mutex>
+#include <span>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace trttl {
+
+/*!
+* Read-only memory mapping of a whole file (RAII).
+*/
+class MappedFile {
+private:
+    const std::byte* ptr = nullptr;
+    std::size_t len = 0;
+
+public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::ios_base::failure("Failed to open weights file: " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::ios_base::failure("Failed to stat weights file: " + path);
+        }
+        len = static_cast<std::size_t>(st.st_size);
+
+        if (len > 0) {
+            void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::ios_base::failure("Failed to mmap weights file: " + path);
+            }
+            ::madvise(p, len, MADV_WILLNEED);
+            ptr = static_cast<const std::byte*>(p);
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (ptr)
+            ::munmap(const_cast<std::byte*>(ptr), len);
+    }
+
+    const std::byte* data() const noexcept { return ptr; }
+    std::size_t size() const noexcept { return len; }
+};
+
+/*!
+* Non-owning description of a tensor inside a mapped file.
+* `owner` keeps the mapping alive as long as the view (or a copy) exists.
+*/
+struct TensorView {
+    std::string dtype;                              /*!< Dtype as spelled in the file.*/
+    std::optional<trt_types::DataType> type;        /*!< TRT dtype if representable.*/
+    std::vector<int64_t> shape;
+    const void* data = nullptr;
+    std::size_t bytes = 0;
+    std::shared_ptr<const MappedFile> owner;
+
+    int64_t count() const noexcept {
+        int64_t r = 1;
+        for (auto s : shape)
+            r *= s;
+        return r;
+    }
+};
+
+/*!
+* Size in bytes of single element of TRT data type.
+*/
+constexpr std::size_t dataTypeSize(trt_types::DataType dt) {
+    switch (dt) {
+        case trt_types::DataType::kFLOAT:
+        case trt_types::DataType::kINT32:
+            return 4;
+        case trt_types::DataType::kHALF:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+/*!
+* Parsed `.npy` header - `offset` is where the payload starts.
+*/
+struct NpyHeader {
+    std::size_t offset = 0;
+    std::string descr;
+    std::vector<int64_t> shape;
+    bool fortran = false;
+};
+
+/*!
+* Parses `.npy` (v1-v3) header from the first `size` bytes of a file, throws if malformed.
+*/
+inline NpyHeader parseNpyHeader(const unsigned char* raw, std::size_t size, const std::string& path) {
+    if (size < 10 || std::memcmp(raw, "\x93NUMPY", 6) != 0)
+        throw std::runtime_error("Not a .npy file: " + path);
+
+    const unsigned major = raw[6];
+    std::size_t header_start = 10;
+    std::size_t header_len = raw[8] | (raw[9] << 8);
+    if (major >= 2) {
+        if (size < 12)
+            throw std::runtime_error("Truncated .npy header: " + path);
+        header_start = 12;
+        header_len = raw[8] | (raw[9] << 8) | (raw[10] << 16) | (static_cast<std::size_t>(raw[11]) << 24);
+    }
+    if (header_start + header_len > size)
+        throw std::runtime_error("Truncated .npy header: " + path);
+
+    NpyHeader h;
+    h.offset = header_start + header_len;
+    parse_utils::Cursor c(std::string_view(reinterpret_cast<const char*>(raw + header_start), header_len));
+    c.object([&](const std::string& key) {
+        if (key == "descr") h.descr = c.string();
+        else if (key == "shape") h.shape = c.int_list();
+        else if (key == "fortran_order") h.fortran = (c.word() == "True");
+        else c.skip_value();
+    });
+    return h;
+}
+
+/*!
+* Process-wide counters of host weight buffers allocated/copied by trttl.
+* Sharing or viewing a buffer never touches them - lets tests prove builds are copy-free.
+*/
+struct WeightStats {
+    static inline std::atomic<std::size_t> allocations{0};  /*!< Buffers allocated.*/
+    static inline std::atomic<std::size_t> bytes{0};        /*!< Bytes allocated/copied.*/
+
+    static void reset() noexcept {
+        allocations.store(0);
+        bytes.store(0);
+    }
+};
+
+/*!
+* Refcounted, type-erased host weight storage.
+* Copies share the same memory; `owner` keeps it alive (vector, mapping or nothing for views).
+*/
+class WeightBuffer {
+private:
+    friend class WeightRegistry;
+
+    std::shared_ptr<const void> owner;
+    const void* ptr = nullptr;
+    int64_t n = 0;
+    trt_types::DataType dt = trt_types::DataType::kFLOAT;
+
+    static void record(std::size_t nbytes) noexcept {
+        WeightStats::allocations.fetch_add(1, std::memory_order_relaxed);
+        WeightStats::bytes.fetch_add(nbytes, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    static WeightBuffer own(std::vector<T>&& src, trt_types::DataType type, bool counted) {
+        if (counted)
+            record(src.size() * sizeof(T));
+        auto holder = std::make_shared<const std::vector<T>>(std::move(src));
+        WeightBuffer r;
+        r.ptr = holder->data();
+        r.n = static_cast<int64_t>(holder->size());
+        r.dt = type;
+        r.owner = std::move(holder);
+        return r;
+    }
+
+public:
+    WeightBuffer() = default;
+
+    /*!
+    * Allocates `count` floats set to `value`.
+    */
+    static WeightBuffer filled(int64_t count, float value) {
+        return adopt(std::vector<float>(static_cast<std::size_t>(count), value), true);
+    }
+
+    /*!
+    * Allocates and copies `src`.
+    */
+    static WeightBuffer copy(std::span<const float> src) {
+        return adopt(std::vector<float>(src.begin(), src.end()), true);
+    }
+
+    /*!
+    * Takes ownership of `src` without copying elements.
+    */
+    static WeightBuffer adopt(std::vector<float>&& src, bool counted = false) {
+        return own(std::move(src), trt_types::DataType::kFLOAT, counted);
+    }
+
+    /*!
+    * Takes ownership of fp16 bit patterns.
+    */
+    static WeightBuffer adoptHalf(std::vector<uint16_t>&& src, bool counted = false) {
+        return own(std::move(src), trt_types::DataType::kHALF, counted);
+    }
+
+    /*!
+    * Non-owning view - caller keeps `src` alive until the network is serialized.
+    */
+    static WeightBuffer view(std::span<const float> src) noexcept {
+        WeightBuffer r;
+        r.ptr = src.data();
+        r.n = static_cast<int64_t>(src.size());
+        return r;
+    }
+
+    /*!
+    * Shares memory-mapped checkpoint tensor.
+    */
+    static WeightBuffer mapped(const TensorView& v) {
+        WeightBuffer r;
+        r.owner = v.owner;
+        r.ptr = v.data;
+        r.n = v.count();
+        r.dt = v.type.value_or(trt_types::DataType::kFLOAT);
+        return r;
+    }
+
+    /*!
+    * Buffer holding the same values as `to` (kFLOAT <-> kHALF) - shares memory if already `to`.
+    */
+    WeightBuffer converted(trt_types::DataType to) const {
+        if (to == dt)
+            return *this;
+        const auto count = static_cast<std::size_t>(n);
+        if (dt == trt_types::DataType::kFLOAT && to == trt_types::DataType::kHALF) {
+            std::vector<uint16_t> h(count);
+            quant_utils::to_fp16(static_cast<const float*>(ptr), h.data(), count);
+            return adoptHalf(std::move(h), true);
+        }
+        if (dt == trt_types::DataType::kHALF && to == trt_types::DataType::kFLOAT) {
+            std::vector<float> f(count);
+            quant_utils::from_fp16(static_cast<const uint16_t*>(ptr), f.data(), count);
+            return adopt(std::move(f), true);
+        }
+        throw std::runtime_error("Unsupported weight conversion.");
+    }
+
+    const void* data() const noexcept { return ptr; }
+    int64_t count() const noexcept { return n; }
+    std::size_t bytes() const noexcept { return static_cast<std::size_t>(n) * dataTypeSize(dt); }
+    trt_types::DataType type() const noexcept { return dt; }
+    bool owning() const noexcept { return owner != nullptr; }
+    long use_count() const noexcept { return owner.use_count(); }
+};
+
+/*!
+* Content-addressed interning of owning `WeightBuffer`s - equal blobs (dtype and bytes) resolve to one buffer,
+* the duplicate is released once its last copy is replaced. Blobs are keyed by `hash_utils::hash_blob` and
+* compared in full on a hit. The registry only holds weak references, so it never keeps weights alive.
+* `Network` interns module parameters into a registry of its own, so equal blobs become one constant tensor
+* (see `SharedConstants`); with `BuildPolicy::intern_weights` it uses `global()` and variants share host memory.
+*/
+class WeightRegistry {
+private:
+    struct Entry {
+        std::weak_ptr<const void> owner;
+        const void* data;
+        std::size_t bytes;
+        trt_types::DataType type;
+    };
+
+    mutable std::mutex mtx;
+    std::unordered_multimap<uint64_t, Entry> blobs;
+    std::unordered_map<const void*, uint64_t> known;        /*!< Interned data pointer -> hash, skips rehashing.*/
+    std::size_t sweep_at = 64;
+    std::size_t shared = 0;
+
+    static WeightBuffer share(const Entry& e, std::shared_ptr<const void> owner, int64_t count) {
+        WeightBuffer r;
+        r.owner = std::move(owner);
+        r.ptr = e.data;
+        r.n = count;
+        r.dt = e.type;
+        return r;
+    }
+
+    /*!
+    * Drops entries whose buffers are gone - amortized over inserts.
+    */
+    void sweep() {
+        if (blobs.size() < sweep_at)
+            return;
+        std::erase_if(blobs, [&](const auto& kv) {
+            if (!kv.second.owner.expired())
+                return false;
+            known.erase(kv.second.data);
+            return true;
+        });
+        sweep_at = std::max<std::size_t>(64, 2 * blobs.size());
+    }
+
+public:
+    WeightRegistry() = default;
+    WeightRegistry(const WeightRegistry&) = delete;
+    WeightRegistry& operator=(const WeightRegistry&) = delete;
+
+    /*!
+    * Process-wide registry used by `Network` with `BuildPolicy::intern_weights`.
+    */
+    static WeightRegistry& global() {
+        static WeightRegistry r;
+        return r;
+    }
+
+    /*!
+    * Buffer with the contents of `w` backed by the first live buffer registered with them.
+    * Views and empty buffers are returned as they are - their lifetime is not ours to extend.
+    */
+    WeightBuffer intern(const WeightBuffer& w) {
+        if (!w.owner || w.bytes() == 0)
+            return w;
+
+        std::unique_lock<std::mutex> lock(mtx);
+        if (auto it = known.find(w.ptr); it != known.end()) {
+            auto [first, last] = blobs.equal_range(it->second);
+            for (; first != last; ++first)
+                if (first->second.data == w.ptr && first->second.bytes == w.bytes() && first->second.type == w.dt)
+                    if (auto owner = first->second.owner.lock())
+                        return share(first->second, std::move(owner), w.n);
+        }
+        lock.unlock();                                      // hash outside the lock, blobs are immutable
+        const uint64_t h = hash_utils::hash_blob(w.ptr, w.bytes());
+        lock.lock();
+
+        auto [first, last] = blobs.equal_range(h);
+        for (; first != last; ++first) {
+            const Entry& e = first->second;
+            if (e.bytes != w.bytes() || e.type != w.dt)
+                continue;
+            auto owner = e.owner.lock();
+            if (owner && (e.data == w.ptr || std::memcmp(e.data, w.ptr, e.bytes) == 0)) {
+                if (e.data != w.ptr)
+                    shared += e.bytes;
+                return share(e, std::move(owner), w.n);
+            }
+        }
+        sweep();
+        blobs.emplace(h, Entry{w.owner, w.ptr, w.bytes(), w.dt});
+        known[w.ptr] = h;
+        return w;
+    }
+
+    /*!
+    * Live unique blobs.
+    */
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return static_cast<std::size_t>(std::count_if(blobs.begin(), blobs.end(),
+                                                      [](const auto& kv) { return !kv.second.owner.expired(); }));
+    }
+
+    /*!
+    * Bytes of duplicates resolved to an existing blob so far.
+    */
+    std::size_t sharedBytes() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return shared;
+    }
+};
+
+/*!
+* Collection of named tensors backed by memory-mapped safetensors / `.npy` files.
+* Only headers are parsed - payloads are never touched or copied.
+*/
+class Checkpoint {
+private:
+    std::unordered_map<std::string, TensorView> tensors;
+
+    static std::optional<trt_types::DataType> fromSafetensors(const std::string& dt) {
+        if (dt == "F32") return trt_types::DataType::kFLOAT;
+        if (dt == "F16") return trt_types::DataType::kHALF;
+        if (dt == "I8") return trt_types::DataType::kINT8;
+        if (dt == "I32") return trt_types::DataType::kINT32;
+        if (dt == "BOOL") return trt_types::DataType::kBOOL;
+        if (dt == "U8") return trt_types::DataType::kUINT8;
+        return std::nullopt;
+    }
+
+    static std::optional<trt_types::DataType> fromNpy(const std::string& descr) {
+        if (descr == "<f4") return trt_types::DataType::kFLOAT;
+        if (descr == "<f2") return trt_types::DataType::kHALF;
+        if (descr == "|i1") return trt_types::DataType::kINT8;
+        if (descr == "<i4") return trt_types::DataType::kINT32;
+        if (descr == "|b1") return trt_types::DataType::kBOOL;
+        if (descr == "|u1") return trt_types::DataType::kUINT8;
+        return std::nullopt;
+    }
+
+    void insert(const std::string& name, TensorView view, const std::string& path) {
+        if (view.type && static_cast<std::size_t>(view.count()) * dataTypeSize(*view.type) != view.bytes)
+            throw std::runtime_error("Tensor `" + name + "` size does not match its shape in " + path);
+        if (!tensors.emplace(name, std::move(view)).second)
+            throw std::runtime_error("Duplicate tensor `" + name + "` in " + path);
+    }
+
+public:
+    /*!
+    * Maps safetensors file and registers all its tensors under `prefix + name`.
+    */
+    void addSafetensors(const std::string& path, const std::string& prefix = "") {
+        TraceSpan span("weights", "Checkpoint::addSafetensors", path);
+        auto file = std::make_shared<const MappedFile>(path);
+        if (file->size() < 8)
+            throw std::runtime_error("Truncated safetensors file: " + path);
+
+        uint64_t header_len = 0;
+        for (int i = 7; i >= 0; --i)
+            header_len = (header_len << 8) | static_cast<uint8_t>(file->data()[i]);
+        if (header_len > file->size() - 8)
+            throw std::runtime_error("Truncated safetensors header: " + path);
+
+        const std::byte* payload = file->data() + 8 + header_len;
+        const std::size_t payload_len = file->size() - 8 - header_len;
+
+        parse_utils::Cursor c(std::string_view(reinterpret_cast<const char*>(file->data() + 8), header_len));
+        c.object([&](const std::string& name) {
+            if (name == "__metadata__") {
+                c.skip_value();
+                return;
+            }
+            TensorView view;
+            std::vector<int64_t> offsets;
+            c.object([&](const std::string& key) {
+                if (key == "dtype") view.dtype = c.string();
+                else if (key == "shape") view.shape = c.int_list();
+                else if (key == "data_offsets") offsets = c.int_list();
+                else c.skip_value();
+            });
+            if (offsets.size() != 2 || offsets[0] < 0 || offsets[1] < offsets[0] ||
+                static_cast<uint64_t>(offsets[1]) > payload_len)
+                throw std::runtime_error("Bad data_offsets for `" + name + "` in " + path);
+
+            view.type = fromSafetensors(view.dtype);
+            view.data = payload + offsets[0];
+            view.bytes = static_cast<std::size_t>(offsets[1] - offsets[0]);
+            view.owner = file;
+            insert(prefix + name, std::move(view), path);
+        });
+    }
+
+    /*!
+    * Maps `.npy` file (v1-v3, C order, little endian) and registers it as `name`.
+    */
+    void addNpy(const std::string& path, const std::string& name) {
+        TraceSpan span("weights", "Checkpoint::addNpy", path);
+        auto file = std::make_shared<const MappedFile>(path);
+        const NpyHeader h = parseNpyHeader(reinterpret_cast<const unsigned char*>(file->data()), file->size(), path);
+        if (h.fortran)
+            throw std::runtime_error("Fortran-ordered .npy is not supported: " + path);
+
+        TensorView view;
+        view.dtype = h.descr;
+        view.shape = h.shape;
+        view.type = fromNpy(view.dtype);
+        view.data = file->data() + h.offset;
+        view.bytes = file->size() - h.offset;
+        view.owner = file;
+        insert(name, std::move(view), path);
+    }
+
+    bool contains(const std::string& name) const {
+        return tensors.contains(name);
+    }
+
+    /*!
+    * Returns tensor view, throws if missing.
+    */
+    const TensorView& get(const std::string& name) const {
+        auto it = tensors.find(name);
+        if (it == tensors.end())
+            throw std::runtime_error("Tensor `" + name + "` not found in checkpoint.");
+        return it->second;
+    }
+
+    /*!
+    * Returns tensor view after checking its dtype and element count/shape.
+    * Shape matches if it equals `shape` after dropping leading/trailing 1s on both sides.
+    */
+    const TensorView& get(const std::string& name, trt_types::DataType dt, std::vector<int64_t> shape) const {
+        const TensorView& view = get(name);
+        if (!view.type || *view.type != dt)
+            throw std::runtime_error("Tensor `" + name + "` has dtype " + view.dtype + " which does not match the module.");
+
+        auto squeeze = [](std::vector<int64_t> s) {
+            while (!s.empty() && s.back() == 1) s.pop_back();
+            while (!s.empty() && s.front() == 1) s.erase(s.begin());
+            return s;
+        };
+        if (squeeze(view.shape) != squeeze(shape)) {
+            std::string got, want;
+            for (auto s : view.shape) got += std::to_string(s) + ",";
+            for (auto s : shape) want += std::to_string(s) + ",";
+            throw std::runtime_error("Tensor `" + name + "` has shape (" + got + ") but module expects (" + want + ").");
+        }
+        return view;
+    }
+
+    std::size_t size() const noexcept { return tensors.size(); }
+};
+
+} // trttl namespace
+#endif // WEIGHTS_HPP
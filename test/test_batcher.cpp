@@ -0,0 +1,135 @@
+#include "../include/trttl.h"
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+#include <array>
+#include <mutex>
+#include <cmath>
+
+using namespace trttl;
+using namespace std::chrono_literals;
+
+using L = LinearLayer<4, trt_types::Dims{2, {1, 3}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+
+// Stub backend: y = [sum(x), n] per row, records batch sizes
+struct StubBackend {
+    std::shared_ptr<std::vector<int32_t>> sizes = std::make_shared<std::vector<int32_t>>();
+    bool fail = false;
+
+    void operator()(const float* x, float* y, int32_t n) {
+        if (fail)
+            throw std::runtime_error("backend failure");
+        sizes->push_back(n);
+        for (int32_t r = 0; r < n; ++r) {
+            y[r * 2] = x[r * 3] + x[r * 3 + 1] + x[r * 3 + 2];
+            y[r * 2 + 1] = static_cast<float>(n);
+        }
+    }
+};
+
+// Test Case for full batches coalesced from concurrent producers
+void testFullBatches() {
+    StubBackend backend;
+    auto sizes = backend.sizes;
+    {
+        Batcher<L, StubBackend> batcher(backend, 10s);
+        static_assert(decltype(batcher)::input_elems == 3 && decltype(batcher)::output_elems == 2);
+
+        constexpr int producers = 4, per_producer = 64;
+        std::vector<std::thread> threads;
+        std::mutex mtx;
+        std::vector<std::pair<float, std::future<std::array<float, 2>>>> futures;
+        for (int t = 0; t < producers; ++t)
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < per_producer; ++i) {
+                    const float v = static_cast<float>(t * 1000 + i);
+                    std::array<float, 3> x{v, 1.f, 2.f};
+                    auto f = batcher.submit(x);
+                    std::lock_guard<std::mutex> lock(mtx);
+                    futures.emplace_back(v + 3.f, std::move(f));
+                }
+            });
+        for (auto& t : threads)
+            t.join();
+        for (auto& [expected, f] : futures)
+            assert(f.get()[0] == expected && "Result scattered to wrong request.");
+
+        const auto m = batcher.metrics();
+        assert(m.requests == producers * per_producer && m.batches == producers * per_producer / 4);
+        assert(m.mean_fill == 1.0 && m.queue_depth == 0);
+    }
+    for (auto n : *sizes)
+        assert(n == 4 && "Deadline should never expire with 10s budget.");
+
+    std::cout << "Full Batches Test Passed!" << std::endl;
+}
+
+// Test Case for partial batch dispatched on deadline
+void testDeadline() {
+    StubBackend backend;
+    Batcher<L, StubBackend> batcher(backend, 2ms);
+
+    std::array<float, 3> x{1.f, 2.f, 3.f};
+    auto f1 = batcher.submit(x);
+    auto f2 = batcher.submit(x);
+    assert(f1.wait_for(1s) == std::future_status::ready && "Partial batch was not flushed.");
+    const auto y = f2.get();
+    assert(y[0] == 6.f && y[1] == 2.f);
+
+    const auto m = batcher.metrics();
+    assert(m.batches == 1 && m.mean_fill == 0.5);
+    assert(m.mean_wait_us >= 1000.0 && "Requests should wait for deadline.");
+
+    std::cout << "Deadline Test Passed!" << std::endl;
+}
+
+// Test Case for backend errors propagated to every request in batch
+void testBackendError() {
+    StubBackend backend;
+    backend.fail = true;
+    Batcher<L, StubBackend> batcher(backend, 1ms);
+
+    std::array<float, 3> x{};
+    auto f = batcher.submit(x);
+    bool thrown = false;
+    try {
+        f.get();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && "Backend exception should reach future.");
+
+    std::cout << "Backend Error Test Passed!" << std::endl;
+}
+
+// Test Case for CpuExecutor backend
+void testCpuBackend() {
+    std::vector<float> w{1.f, 0.f, 1.f, 0.f, 1.f, 1.f}, b{0.5f, -0.5f};
+    Batcher<L, CpuExecutor<L>> batcher(CpuExecutor<L>(L(w, b)), 1ms);
+
+    std::array<float, 3> x{1.f, 2.f, 3.f};
+    const auto y = batcher.submit(x).get();
+    assert(std::fabs(y[0] - 4.5f) < 1e-6f && std::fabs(y[1] - 4.5f) < 1e-6f);
+
+    std::cout << "CPU Backend Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testFullBatches();
+        testDeadline();
+        testBackendError();
+        testCpuBackend();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
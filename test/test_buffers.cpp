@@ -0,0 +1,93 @@
+#include "../include/trttl.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <set>
+
+using namespace trttl;
+
+using L = LinearLayer<4, trt_types::Dims{2, {1, 3}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+
+// Test Case for compile-time volume/stride helpers and buffer layout
+void testBufferLayout() {
+    constexpr trt_types::Dims d{3, {2, 3, 4}};
+    static_assert(dimVolume(d) == 24);
+    static_assert(dimStrides(d) == trt_types::Dims{3, {12, 4, 1}});
+
+    static_assert(InputBuffer<L>::size == 12 && OutputBuffer<L>::size == 8);
+    static_assert(InputBuffer<L>::sample_size == 3 && InputBuffer<L>::batch_size == 4);
+    static_assert(alignof(InputBuffer<L>) == 64);
+    static_assert(std::is_same_v<InputBuffer<L>::value_type, float>);
+
+    InputBuffer<L> in{};
+    auto s = in.sample(2);
+    s[1] = 5.f;
+    assert(in[2 * 3 + 1] == 5.f && "Sample view should alias batch storage.");
+
+    std::cout << "Buffer Layout Test Passed!" << std::endl;
+}
+
+// Test Case for pool handing out distinct aligned buffers and taking them back
+void testPool() {
+    BufferPool<InputBuffer<L>, 4> pool;
+    assert(pool.available() == 4);
+    {
+        std::vector<BufferPool<InputBuffer<L>, 4>::Lease> leases;
+        std::set<void*> seen;
+        for (int i = 0; i < 4; ++i) {
+            leases.push_back(pool.acquire());
+            assert(reinterpret_cast<uintptr_t>(leases.back().get()) % 64 == 0 && "Buffer not 64-byte aligned.");
+            seen.insert(leases.back().get());
+        }
+        assert(seen.size() == 4 && pool.available() == 0);
+        assert(!pool.try_acquire() && "Exhausted pool should return empty lease.");
+    }
+    assert(pool.available() == 4 && "Leases should return buffers on destruction.");
+
+    std::cout << "Pool Test Passed!" << std::endl;
+}
+
+// Test Case for blocking acquire under contention with executor round-trips
+void testPoolContention() {
+    BufferPool<InputBuffer<L>, 2> inputs;
+    BufferPool<OutputBuffer<L>, 2> outputs;
+    std::vector<float> w{1.f, 0.f, 1.f, 0.f, 1.f, 1.f}, b{0.f, 0.f};
+    const L layer(w, b);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&, t] {
+            CpuExecutor<L> executor(layer);
+            for (int i = 0; i < 200; ++i) {
+                auto in = inputs.acquire();
+                auto out = outputs.acquire();
+                for (auto& v : *in)
+                    v = static_cast<float>(t);
+                executor.run(*in, *out);
+                for (int r = 0; r < L::batch_size; ++r)
+                    assert((*out).sample(r)[0] == 2.f * t && "Buffer shared between leases.");
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+    assert(inputs.available() == 2 && outputs.available() == 2);
+
+    std::cout << "Pool Contention Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testBufferLayout();
+        testPool();
+        testPoolContention();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "../include/trttl.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <atomic>
+#include <future>
+#include <latch>
+#include <mutex>
+#include <vector>
+
+using namespace trttl;
+
+template<int32_t bs>
+using L1 = LinearLayer<bs, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>;
+template<int32_t bs>
+using L2 = LinearLayer<bs, trt_types::Dims{2, {1, 5}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+template<int32_t bs>
+using Act = ActivationLayer<bs, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+template<int32_t bs>
+using Model = Sequential<bs, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT, L1<bs>, Act<bs>, L2<bs>>;
+
+// Monitor recording callbacks, optionally refusing a step
+struct RecordingMonitor : BuildMonitor {
+    std::mutex mtx;
+    std::vector<std::string> events;
+    int32_t stop_at = -1;
+
+    void phaseStart(const char* phase, const char*, int32_t steps) noexcept override {
+        std::lock_guard<std::mutex> lock(mtx);
+        events.push_back(std::string("start ") + phase + " " + std::to_string(steps));
+    }
+
+    bool stepComplete(const char* phase, int32_t step) noexcept override {
+        std::lock_guard<std::mutex> lock(mtx);
+        events.push_back(std::string("step ") + phase + " " + std::to_string(step));
+        return step != stop_at;
+    }
+
+    void phaseFinish(const char* phase) noexcept override {
+        std::lock_guard<std::mutex> lock(mtx);
+        events.push_back(std::string("finish ") + phase);
+    }
+};
+
+// Test Case for concurrent builds matching synchronous ones
+void testParallelBuilds() {
+    DefaultLogger logger;
+    Plan expected1, expected4;
+    {
+        trttl::Network<Model<1>> net(logger);
+        auto m = net.serialize();
+        expected1.assign(static_cast<const char*>(m->data()), static_cast<const char*>(m->data()) + m->size());
+        trttl::Network<Model<4>> net4(logger);
+        auto m4 = net4.serialize();
+        expected4.assign(static_cast<const char*>(m4->data()), static_cast<const char*>(m4->data()) + m4->size());
+    }
+
+    BuildPool pool(4);
+    std::latch together(4);
+    auto rendezvous = [&](auto&) { together.arrive_and_wait(); };   // deadlocks unless 4 builds run at once
+    std::vector<BuildJob> jobs;
+    jobs.push_back(pool.submit(logger, Model<1>(), {}, rendezvous));
+    jobs.push_back(pool.submit(logger, Model<4>(), {}, rendezvous));
+    jobs.push_back(pool.submit(logger, Model<1>(), {}, rendezvous));
+    jobs.push_back(pool.submit(logger, Model<4>(), {}, rendezvous));
+
+    assert(jobs[0].get() == expected1 && jobs[2].get() == expected1);
+    assert(jobs[1].get() == expected4 && jobs[3].get() == expected4);
+    pool.wait();
+    assert(pool.pending() == 0);
+
+    std::cout << "Parallel Builds Test Passed!" << std::endl;
+}
+
+// Test Case for cancelling queued and running jobs
+void testCancellation() {
+    DefaultLogger logger;
+    BuildPool pool(1);
+
+    std::promise<void> release;
+    auto gate = release.get_future().share();
+    auto blocked = pool.submit(logger, Model<1>(), {}, [gate](auto&) { gate.wait(); });
+    auto queued = pool.submit(logger, Model<2>());
+    queued.cancel();
+    blocked.cancel();
+    release.set_value();
+
+    bool threw = false;
+    try { blocked.get(); } catch (const BuildCancelled&) { threw = true; }
+    assert(threw && "Running job should stop at next step.");
+    threw = false;
+    try { queued.get(); } catch (const BuildCancelled&) { threw = true; }
+    assert(threw && "Queued job should never start.");
+
+    auto failing = pool.submit(logger, Model<1>(), {}, [](auto&) { throw std::runtime_error("setup"); });
+    threw = false;
+    try { failing.get(); } catch (const std::runtime_error& e) { threw = std::string(e.what()) == "setup"; }
+    assert(threw && "Build errors should propagate through future.");
+
+    std::cout << "Cancellation Test Passed!" << std::endl;
+}
+
+// Test Case for progress callbacks and cancelling through monitor
+void testProgress() {
+    DefaultLogger logger;
+    RecordingMonitor monitor;
+    BuildPool pool(1);
+
+    pool.submit(logger, Model<1>(), {"m1", nullptr, nullptr, &monitor}).get();
+    const std::vector<std::string> expected{"start m1 3", "step m1 0", "step m1 1", "step m1 2", "finish m1"};
+    assert(monitor.events == expected);
+
+    monitor.events.clear();
+    monitor.stop_at = 0;
+    auto job = pool.submit(logger, Model<1>(), {"m2", nullptr, nullptr, &monitor});
+    bool threw = false;
+    try { job.get(); } catch (const BuildCancelled&) { threw = true; }
+    assert(threw && monitor.events.size() == 3 && monitor.events.back() == "finish m2");
+
+    std::cout << "Progress Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testParallelBuilds();
+        testCancellation();
+        testProgress();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
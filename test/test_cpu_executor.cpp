@@ -0,0 +1,141 @@
+#include "../include/trttl.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <cmath>
+
+using namespace trttl;
+
+std::vector<float> randomVector(std::size_t n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-2.f, 2.f);
+    std::vector<float> v(n);
+    for (auto& x : v)
+        x = dist(gen);
+    return v;
+}
+
+bool close(const std::vector<float>& a, const std::vector<float>& b, float tol = 1e-5f) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        if (std::fabs(a[i] - b[i]) > tol * (1.f + std::fabs(b[i])))
+            return false;
+    return true;
+}
+
+// Test Case for linear kernel against naive loop (odd shapes exercise vector tails)
+void testLinearKernel() {
+    constexpr std::size_t rows = 3, K = 19, N = 77;
+    auto x = randomVector(rows * K, 1), w = randomVector(K * N, 2), b = randomVector(N, 3);
+    std::vector<float> naive(rows * N), simd(rows * N), scalar(rows * N);
+
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t n = 0; n < N; ++n) {
+            double acc = b[n];
+            for (std::size_t k = 0; k < K; ++k)
+                acc += static_cast<double>(x[r * K + k]) * w[n * K + k];
+            naive[r * N + n] = static_cast<float>(acc);
+        }
+
+    cpu_kernels::linear<simd_utils::Native, rows, K, N>(x.data(), w.data(), b.data(), simd.data());
+    cpu_kernels::linear<simd_utils::Scalar, rows, K, N>(x.data(), w.data(), b.data(), scalar.data());
+    assert(close(simd, naive, 1e-4f) && "SIMD linear mismatch.");
+    assert(close(scalar, naive, 1e-4f) && "Scalar linear mismatch.");
+
+    std::cout << "Linear Kernel Test Passed! (" << simd_utils::Native::name << ")" << std::endl;
+}
+
+// Test Case for vectorized activations and softmax against scalar reference
+void testElementwiseKernels() {
+    auto x = randomVector(133, 4);
+    for (auto& v : x)
+        v *= 10.f;
+    std::vector<float> simd(x.size()), scalar(x.size());
+
+    cpu_kernels::activation<simd_utils::Native, trt_types::ActivationType::kRELU>(x.data(), simd.data(), x.size());
+    cpu_kernels::activation<simd_utils::Scalar, trt_types::ActivationType::kRELU>(x.data(), scalar.data(), x.size());
+    assert(close(simd, scalar) && "ReLU mismatch.");
+
+    cpu_kernels::activation<simd_utils::Native, trt_types::ActivationType::kSIGMOID>(x.data(), simd.data(), x.size());
+    cpu_kernels::activation<simd_utils::Scalar, trt_types::ActivationType::kSIGMOID>(x.data(), scalar.data(), x.size());
+    assert(close(simd, scalar) && "Sigmoid mismatch.");
+
+    cpu_kernels::activation<simd_utils::Native, trt_types::ActivationType::kTANH>(x.data(), simd.data(), x.size());
+    cpu_kernels::activation<simd_utils::Scalar, trt_types::ActivationType::kTANH>(x.data(), scalar.data(), x.size());
+    assert(close(simd, scalar) && "Tanh mismatch.");
+
+    cpu_kernels::softmax<simd_utils::Native>(x.data(), simd.data(), 7, 19);
+    cpu_kernels::softmax<simd_utils::Scalar>(x.data(), scalar.data(), 7, 19);
+    assert(close(simd, scalar) && "Softmax mismatch.");
+    float sum = 0.f;
+    for (std::size_t i = 0; i < 19; ++i)
+        sum += simd[i];
+    assert(std::fabs(sum - 1.f) < 1e-5f && "Softmax row should sum to 1.");
+
+    std::cout << "Elementwise Kernels Test Passed!" << std::endl;
+}
+
+using L1 = LinearLayer<2, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 40}}, trt_types::DataType::kFLOAT>;
+using A1 = ActivationLayer<2, trt_types::Dims{2, {1, 40}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+using L2 = LinearLayer<2, trt_types::Dims{2, {1, 40}}, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kFLOAT>;
+using S = SoftmaxLayer<2, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kFLOAT>;
+using Model = Sequential<2, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kFLOAT, L1, A1, L2, S>;
+
+// Test Case for executing Sequential model end-to-end
+void testExecutor() {
+    auto w1 = randomVector(10 * 40, 5), b1 = randomVector(40, 6);
+    auto w2 = randomVector(40 * 3, 7), b2 = randomVector(3, 8);
+    auto x = randomVector(2 * 10, 9);
+
+    Model model(L1(w1, b1), A1(), L2(w2, b2), S());
+    CpuExecutor<Model> executor(model);
+    CpuExecutor<Model, simd_utils::Scalar> reference(model);
+    static_assert(CpuExecutor<Model>::input_size == 20 && CpuExecutor<Model>::output_size == 6);
+    static_assert(Model::workspace() == 2 * 80, "Two ping-pong buffers sized for widest layer.");
+
+    std::vector<float> out(6), ref(6), expected(6);
+    executor.run(x.data(), out.data());
+    reference.run(x.data(), ref.data());
+
+    for (int r = 0; r < 2; ++r) {
+        float h[40], z[3], m = -1e30f, s = 0.f;
+        for (int n = 0; n < 40; ++n) {
+            h[n] = b1[n];
+            for (int k = 0; k < 10; ++k)
+                h[n] += x[r * 10 + k] * w1[n * 10 + k];
+            h[n] = std::max(h[n], 0.f);
+        }
+        for (int n = 0; n < 3; ++n) {
+            z[n] = b2[n];
+            for (int k = 0; k < 40; ++k)
+                z[n] += h[k] * w2[n * 40 + k];
+            m = std::max(m, z[n]);
+        }
+        for (int n = 0; n < 3; ++n)
+            s += (z[n] = std::exp(z[n] - m));
+        for (int n = 0; n < 3; ++n)
+            expected[r * 3 + n] = z[n] / s;
+    }
+    assert(close(out, expected, 1e-4f) && "Executor output mismatch.");
+    assert(close(ref, expected, 1e-4f) && "Scalar executor output mismatch.");
+
+    std::cout << "CPU Executor Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testLinearKernel();
+        testElementwiseKernels();
+        testExecutor();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
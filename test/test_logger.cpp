@@ -1,7 +1,17 @@
 #include "../include/trttl.h"
+#include <filesystem>
+#include <iterator>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 #include <cassert>
+#include <cstring>
+#include <ctime>
+#include <sys/resource.h>
+#include <unistd.h>
 
 using namespace trttl;
 
@@ -61,12 +71,349 @@ void test_logger_no_log() {
     std::cout << "NoLog fallback test passed (if no output above).\n";
 }
 
+// In-memory stream for checking what async logger wrote
+class StringLog : public LogStream<StringLog>{
+public:
+    static std::ostringstream& buffer() {
+        static std::ostringstream ss;
+        return ss;
+    }
+
+    std::ostream& get_impl(){
+        return buffer();
+    }
+};
+
+std::size_t count_lines(const std::string& s) {
+    std::size_t n = 0;
+    for (char c : s)
+        n += (c == '\n');
+    return n;
+}
+
+// Test async logger writes everything on destruction
+void test_async_logger_flush_on_destruction() {
+    StringLog::buffer().str("");
+    {
+        AsyncLogger<StringLog, StringLog, StringLog, StringLog, StringLog> logger;
+        for (int i = 0; i < 100; ++i)
+            logger.log(trt_types::Severity::kINFO, "Async info log.");
+    }
+    const std::string out = StringLog::buffer().str();
+    assert(count_lines(out) == 100 && "All records should be written.");
+    assert(out.rfind("[I] ", 0) == 0 && "Prefix should match sync logger.");
+
+    std::cout << "Async logger flush on destruction test passed.\n";
+}
+
+// Test async logger from multiple producers with blocking policy
+void test_async_logger_multi_producer() {
+    StringLog::buffer().str("");
+    {
+        AsyncLogger<NoLog, NoLog, StringLog, StringLog, NoLog,
+                    trt_types::Severity::kERROR, OverflowPolicy::kBLOCK, 16> logger;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&logger] {
+                for (int i = 0; i < 250; ++i)
+                    logger.log(trt_types::Severity::kWARNING, "Async warning log.");
+            });
+        for (auto& t : threads)
+            t.join();
+
+        logger.log(trt_types::Severity::kVERBOSE, "Routed to NoLog.");
+        logger.flush();
+        assert(count_lines(StringLog::buffer().str()) == 1000 && "Blocking policy must not lose records.");
+        assert(logger.dropped() == 0);
+    }
+
+    std::cout << "Async logger multi producer test passed.\n";
+}
+
+// Test async logger drop policies account for every record
+template<OverflowPolicy policy>
+void test_async_logger_drop() {
+    StringLog::buffer().str("");
+    uint64_t dropped = 0;
+    {
+        AsyncLogger<StringLog, StringLog, StringLog, StringLog, StringLog,
+                    trt_types::Severity::kERROR, policy, 4> logger;
+        for (int i = 0; i < 1000; ++i)
+            logger.log(trt_types::Severity::kINFO, "Async drop log.");
+        logger.flush();
+        dropped = logger.dropped();
+    }
+    assert(count_lines(StringLog::buffer().str()) + dropped == 1000 && "Written + dropped should equal produced.");
+
+    std::cout << "Async logger drop policy test passed.\n";
+}
+
+// Test async logger flushes before throwing
+void test_async_logger_throw() {
+    StringLog::buffer().str("");
+    AsyncLogger<StringLog, StringLog> logger;
+    bool thrown = false;
+    try {
+        logger.print<trt_types::Severity::kERROR>("Async error log.");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && "Error severity should throw.");
+    assert(count_lines(StringLog::buffer().str()) == 1 && "Error should be written before throw.");
+
+    std::cout << "Async logger throw test passed.\n";
+}
+
+// Test binary sink decodes to the text layout, with one site entry per call site
+void test_binary_log() {
+    {
+        Logger<BinaryLog, BinaryLog, BinaryLog, BinaryLog, BinaryLog> logger;
+        for (int i = 0; i < 50; ++i)
+            logger.print<trt_types::Severity::kINFO>("Binary info log.");
+        logger.print<trt_types::Severity::kWARNING>("Binary warning log.");
+        logger.log(trt_types::Severity::kVERBOSE, "Binary verbose log.");
+    }
+    {
+        BinaryLogReader reader("trt.blog");
+        std::ostringstream out;
+        assert(reader.decode(out) == 52 && reader.siteCount() == 3 && "Sites should be stored once.");
+        const std::string text = out.str();
+        assert(count_lines(text) == 52 && text.rfind("[I] ", 0) == 0);
+        assert(text.find("test_logger.cpp(") != std::string::npos && text.find("`: Binary warning log.\n[V] ") != std::string::npos);
+
+        const std::time_t now = std::time(nullptr);
+        const std::string stamp = text.substr(4, std::strlen(LogFormat::timestamp(now)));
+        assert((stamp == LogFormat::timestamp(now) || stamp == LogFormat::timestamp(now - 1)) && "Ticks should map to wall time.");
+    }
+
+    // Async logger passes producer timestamps through, truncated tail is skipped
+    {
+        AsyncLogger<NoLog, NoLog, BinaryLog, BinaryLog, NoLog> logger;
+        for (int i = 0; i < 100; ++i)
+            logger.log(trt_types::Severity::kWARNING, "Async binary log.");
+    }
+    std::filesystem::resize_file("trt.blog", std::filesystem::file_size("trt.blog") - 3);
+    std::ostringstream out;
+    BinaryLogReader reader("trt.blog");
+    assert(reader.decode(out) == 99 && "Partial record should be ignored.");
+    std::filesystem::remove("trt.blog");
+
+    std::cout << "Binary log test passed.\n";
+}
+
+std::size_t count_occurrences(const std::string& s, const std::string& what) {
+    std::size_t n = 0;
+    for (auto pos = s.find(what); pos != std::string::npos; pos = s.find(what, pos + 1))
+        ++n;
+    return n;
+}
+
+// Test sampling, rate limiting and suppression summaries
+void test_log_limits() {
+    StringLog::buffer().str("");
+    uint64_t dropped = 0;
+    {
+        Logger<StringLog, StringLog, StringLog, StringLog, StringLog> logger;
+        logger.limits().limit(trt_types::Severity::kVERBOSE, {.sample_every = 10});
+        logger.limits().limit(trt_types::Severity::kINFO, "[Tactic]", {.rate = 1.0, .burst = 5.0});
+
+        for (int i = 0; i < 100; ++i)
+            logger.log(trt_types::Severity::kVERBOSE, "Sampled verbose log.");
+        for (int i = 0; i < 100; ++i)
+            logger.log(trt_types::Severity::kINFO, "[Tactic] Rate limited info log.");
+        for (int i = 0; i < 10; ++i)
+            logger.log(trt_types::Severity::kINFO, "Unmatched info log.");
+        dropped = logger.limits().dropped();
+    }
+    const std::string out = StringLog::buffer().str();
+    assert(count_occurrences(out, "Sampled verbose log.") == 10 && "1 in 10 should pass.");
+    assert(count_occurrences(out, "Rate limited info log.") == 5 && "Burst should pass, rest limited.");
+    assert(count_occurrences(out, "Unmatched info log.") == 10);
+    assert(dropped == 90 + 95);
+    assert(count_occurrences(out, "Suppressed 9 similar messages.") == 10 && "Summary per gap and on destruction.");
+    assert(count_occurrences(out, "Suppressed 95 similar messages (\"[Tactic]\").") == 1);
+
+    // Sampling stays exact under concurrency, async logger too
+    StringLog::buffer().str("");
+    {
+        AsyncLogger<StringLog, StringLog, StringLog, StringLog, StringLog> logger;
+        logger.limits().limit(trt_types::Severity::kVERBOSE, {.sample_every = 10});
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&logger] {
+                for (int i = 0; i < 1000; ++i)
+                    logger.log(trt_types::Severity::kVERBOSE, "Concurrent verbose log.");
+            });
+        for (auto& t : threads)
+            t.join();
+        logger.flush();
+        assert(logger.limits().dropped() == 3600);
+    }
+    assert(count_occurrences(StringLog::buffer().str(), "Concurrent verbose log.") == 400);
+
+    std::cout << "Log limits test passed.\n";
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream fin(path);
+    return std::string(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>());
+}
+
+void remove_logs(const std::string& path) {
+    for (const auto& p : {path, path + ".1", path + ".2", path + ".3"})
+        std::filesystem::remove(p);
+}
+
+constexpr LogFileConfig rotate_config{.path = "test_rotate.log", .max_bytes = 4096, .keep = 2, .flush = FlushPolicy::kLINE};
+constexpr LogFileConfig batch_config{.path = "test_batch.log", .flush = FlushPolicy::kBYTES | FlushPolicy::kERROR,
+                                     .flush_bytes = 1 << 20};
+constexpr LogFileConfig periodic_config{.path = "test_periodic.log", .flush = FlushPolicy::kPERIODIC, .flush_ms = 20};
+constexpr LogFileConfig respelled_config{.path = "./test_batch.log", .flush = FlushPolicy::kBYTES | FlushPolicy::kERROR,
+                                         .flush_bytes = 1 << 20};
+constexpr LogFileConfig rekept_config{.path = "test_batch.log", .keep = 1, .flush = FlushPolicy::kBYTES | FlushPolicy::kERROR,
+                                      .flush_bytes = 1 << 20};
+constexpr LogFileConfig exhaust_config{.path = "test_exhaust.log", .max_bytes = 256, .keep = 3, .flush = FlushPolicy::kLINE};
+
+// Test rotating file sink - appending, size rotation, flush policies, sharing between loggers
+void test_rotating_log() {
+    remove_logs("test_rotate.log");
+    {
+        Logger<NoLog, NoLog, NoLog, RotatingFileLog<rotate_config>, NoLog> logger;
+        for (int i = 0; i < 200; ++i)
+            logger.log(trt_types::Severity::kINFO, "Rotated info log.");
+    }
+    assert(std::filesystem::exists("test_rotate.log.2") && !std::filesystem::exists("test_rotate.log.3") && "Keep 2 rotated files.");
+    for (const auto& p : {"test_rotate.log", "test_rotate.log.1", "test_rotate.log.2"}) {
+        assert(std::filesystem::file_size(p) <= 4096);
+        const std::string text = read_file(p);
+        assert(!text.empty() && text.back() == '\n' && "Lines should not be split between files.");
+    }
+    const std::string newest = read_file("test_rotate.log");
+    assert(count_occurrences(newest, "Rotated info log.") == count_occurrences(newest, "\n"));
+    remove_logs("test_rotate.log");
+
+    // Buffered until error line, then everything goes out in order
+    remove_logs("test_batch.log");
+    {
+        std::ofstream("test_batch.log") << "Previous run.\n";
+    }
+    {
+        Logger<NoLog, RotatingFileLog<batch_config>, NoLog, RotatingFileLog<batch_config>, NoLog, trt_types::Severity::kINTERNAL_ERROR> logger;
+        for (int i = 0; i < 100; ++i)
+            logger.log(trt_types::Severity::kINFO, "Batched info log.");
+        assert(read_file("test_batch.log") == "Previous run.\n" && "Info lines should stay buffered, file appended to.");
+        logger.log(trt_types::Severity::kERROR, "Batched error log.");
+        const std::string text = read_file("test_batch.log");
+        assert(count_occurrences(text, "Batched info log.") == 100 && text.find("Batched error log.") > text.rfind("Batched info log."));
+        logger.log(trt_types::Severity::kINFO, "Batched tail log.");
+    }
+    assert(count_occurrences(read_file("test_batch.log"), "Batched tail log.") == 1 && "Flushed on destruction.");
+
+    // Sync and async loggers share one file without interleaving lines
+    {
+        Logger<NoLog, NoLog, NoLog, RotatingFileLog<batch_config>, NoLog> sync;
+        AsyncLogger<NoLog, NoLog, NoLog, RotatingFileLog<batch_config>, NoLog> async;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 500; ++i) {
+                    if (t % 2)
+                        sync.log(trt_types::Severity::kINFO, "Shared sync log.");
+                    else
+                        async.log(trt_types::Severity::kINFO, "Shared async log.");
+                }
+            });
+        for (auto& t : threads)
+            t.join();
+    }
+    const std::string shared = read_file("test_batch.log");
+    assert(count_occurrences(shared, "Shared sync log.\n") == 1000 && count_occurrences(shared, "Shared async log.\n") == 1000);
+    assert(count_occurrences(shared, "\n") == 2103 && "Every line should be intact.");
+    remove_logs("test_batch.log");
+
+    // Periodic flush reaches the file while the logger is idle
+    remove_logs("test_periodic.log");
+    {
+        Logger<NoLog, NoLog, NoLog, RotatingFileLog<periodic_config>, NoLog> logger;
+        logger.log(trt_types::Severity::kINFO, "Quiet tail log.");
+        for (int i = 0; i < 500 && read_file("test_periodic.log").empty(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(count_occurrences(read_file("test_periodic.log"), "Quiet tail log.") == 1 && "Idle buffer should be flushed by timer.");
+    }
+    remove_logs("test_periodic.log");
+
+    // Sinks of one path must agree on settings, however the path is spelled
+    {
+        Logger<NoLog, NoLog, NoLog, RotatingFileLog<batch_config>, NoLog> logger;
+        Logger<NoLog, NoLog, NoLog, RotatingFileLog<respelled_config>, NoLog> same;
+        bool thrown = false;
+        try {
+            Logger<NoLog, NoLog, NoLog, RotatingFileLog<rekept_config>, NoLog> other;
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        assert(thrown && "Different settings for an open file should be rejected.");
+    }
+    remove_logs("test_batch.log");
+
+    std::cout << "Rotating log test passed.\n";
+}
+
+// Test rotation while the next file can't be opened - no archive is shifted, no line is lost
+void test_rotating_log_exhausted() {
+    remove_logs("test_exhaust.log");
+    {
+        Logger<NoLog, NoLog, NoLog, RotatingFileLog<exhaust_config>, NoLog> logger;
+        for (int i = 0; i < 20; ++i)
+            logger.log(trt_types::Severity::kINFO, "Before exhaustion.");
+        assert(std::filesystem::exists("test_exhaust.log.3"));
+        const std::string archived1 = read_file("test_exhaust.log.1"), archived2 = read_file("test_exhaust.log.2");
+
+        rlimit old{};
+        ::getrlimit(RLIMIT_NOFILE, &old);
+        rlimit low = old;
+        low.rlim_cur = std::min<rlim_t>(old.rlim_cur, 64);
+        ::setrlimit(RLIMIT_NOFILE, &low);
+        std::vector<int> held;
+        for (int f; (f = ::dup(0)) >= 0;)
+            held.push_back(f);
+        for (int i = 0; i < 3; ++i)
+            logger.log(trt_types::Severity::kINFO, "During exhaustion.");
+        for (int f : held)
+            ::close(f);
+        ::setrlimit(RLIMIT_NOFILE, &old);
+
+        assert(read_file("test_exhaust.log.1") == archived1 && read_file("test_exhaust.log.2") == archived2 &&
+               "Failed rotation should not shift archives.");
+        assert(count_occurrences(read_file("test_exhaust.log"), "During exhaustion.") == 3 && "Lines go to the current file.");
+
+        logger.log(trt_types::Severity::kINFO, "After exhaustion.");
+        assert(count_occurrences(read_file("test_exhaust.log.1"), "During exhaustion.") == 3 && "Recovered rotation shifts once.");
+        assert(read_file("test_exhaust.log.2") == archived1 && read_file("test_exhaust.log.3") == archived2);
+        assert(count_occurrences(read_file("test_exhaust.log"), "After exhaustion.") == 1);
+    }
+    assert(!std::filesystem::exists("test_exhaust.log.next"));
+    remove_logs("test_exhaust.log");
+
+    std::cout << "Rotating log exhaustion test passed.\n";
+}
+
 int main() {
     try {
         test_logger_custom_streams();
         test_logger_default();
         test_logger_thread_safety();
         test_logger_no_log();
+        test_async_logger_flush_on_destruction();
+        test_async_logger_multi_producer();
+        test_async_logger_drop<OverflowPolicy::kDROP_NEWEST>();
+        test_async_logger_drop<OverflowPolicy::kDROP_OLDEST>();
+        test_async_logger_throw();
+        test_binary_log();
+        test_log_limits();
+        test_rotating_log();
+        test_rotating_log_exhausted();
 
         std::cout << "All tests passed!\n";
     } catch (const std::exception& e) {
@@ -3,7 +3,9 @@
 #include <iostream>
 #include <cassert>
 #include <memory>
+#include <string>
 #include <vector>
+#include <cmath>
 
 using namespace trttl;
 
@@ -161,6 +163,378 @@ void testTensorRTEngine() {
     std::cout << "TensorRT Engine Test Passed!" << std::endl;
 }
 
+// Test Case for building a model without copying weights
+void testZeroWeightCopies() {
+    DefaultLogger logger;
+
+    using L1 = LinearLayer<1, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>;
+    using L2 = LinearLayer<1, trt_types::Dims{2, {1, 5}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+    using Seq = Sequential<1, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT, L1, L2>;
+
+    std::vector<float> weights2(10, 0.1f);
+    std::vector<float> biases2(2, 0.0f);
+    L1 layer1(std::vector<float>(50, 0.1f), std::vector<float>(5, 0.0f));
+    L2 layer2(WeightBuffer::view(weights2), WeightBuffer::view(biases2));
+    const void* w1 = layer1.weights().data();
+
+    WeightStats::reset();
+    {
+        Seq seq(layer1, std::move(layer2));
+        assert(layer1.weights().use_count() == 2 && "Copied layer should share weights.");
+
+        trttl::Network network(logger, std::move(seq));
+        auto buffer = network.serialize();
+    }
+    // L1 -> L2 is folded into one [10 x 2] layer - its parameters are the only allocation
+    assert(WeightStats::allocations == 2 && WeightStats::bytes == (10 * 2 + 2) * sizeof(float) &&
+           "Model build should not copy weights.");
+    assert(layer1.weights().data() == w1);
+
+    bool thrown = false;
+    try {
+        L2 bad(std::vector<float>(3, 0.f), std::vector<float>(2, 0.f));
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && "Parameter count mismatch should be rejected.");
+
+    std::cout << "Zero Weight Copies Test Passed!" << std::endl;
+}
+
+// Whether Sequential with given batch range/output shape accepts modules
+template<BatchSize bs, trt_types::Dims out, typename... Ms>
+concept ValidSequential = requires { typename Sequential<bs, trt_types::Dims{2, {1, 10}}, out, trt_types::DataType::kFLOAT, Ms...>; };
+
+// Test Case for dynamic batch ranges
+void testDynamicBatch() {
+    DefaultLogger logger;
+
+    constexpr BatchSize range{1, 8, 32};
+    using L1 = LinearLayer<range, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>;
+    using A = ActivationLayer<BatchSize{1, 4, 64}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+    using L2 = LinearLayer<range, trt_types::Dims{2, {1, 5}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+    using Seq = Sequential<range, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT, L1, A, L2>;
+
+    static_assert(Seq::batch_range.dynamic() && Seq::batch_size == 32, "Max of range sizes host buffers.");
+    static_assert(ValidSequential<range, trt_types::Dims{2, {1, 2}}, L1, A, L2>);
+    static_assert(!ValidSequential<BatchSize{1, 8, 128}, trt_types::Dims{2, {1, 2}}, L1, A, L2>,
+                  "Sequential range wider than its layers must be rejected.");
+    static_assert(!ValidSequential<range, trt_types::Dims{2, {1, 5}}, LinearLayer<4, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>>,
+                  "Fixed batch layer cannot serve a dynamic range.");
+
+    auto paramDims = L1::calcParamDims();
+    assert(std::get<0>(paramDims).d[0] == 1 && std::get<1>(paramDims).d[0] == 1 && "Parameters should broadcast over batch.");
+
+    trttl::Network network(logger, Seq());
+    auto buffer = network.serialize();
+
+    std::cout << "Dynamic Batch Test Passed!" << std::endl;
+}
+
+// Test Case for compile-time folding/fusion in Sequential lowering
+void testRewrite() {
+    using DT = trt_types::DataType;
+    constexpr trt_types::Dims d10{2, {1, 10}}, d5{2, {1, 5}}, d3{2, {1, 3}}, d2{2, {1, 2}};
+    using L1 = LinearLayer<2, d10, d5, DT::kFLOAT>;
+    using L2 = LinearLayer<2, d5, d3, DT::kFLOAT>;
+    using I = IdentityLayer<2, d5, DT::kFLOAT>;
+    using A = ActivationLayer<2, d5, DT::kFLOAT, trt_types::ActivationType::kRELU>;
+    using S = SoftmaxLayer<2, d3, DT::kFLOAT>;
+
+    // Linear -> Identity -> Linear folds into one [10 x 3] layer
+    using Merged = Sequential<2, d10, d3, DT::kFLOAT, L1, I, L2>;
+    static_assert(std::is_same_v<Merged::Lowered, std::tuple<LinearLayer<2, d10, d3, DT::kFLOAT>>>);
+
+    // Linear -> Activation fuses, Softmax stays
+    using Fused = Sequential<2, d10, d3, DT::kFLOAT, L1, A, L2, S>;
+    static_assert(std::is_same_v<Fused::Lowered, std::tuple<FusedLinearLayer<2, d10, d5, DT::kFLOAT, trt_types::ActivationType::kRELU>, L2, S>>);
+
+    // Bottleneck [10 x 2] * [2 x 10] would grow to [10 x 10] - kept apart
+    using Bottleneck = Sequential<2, d10, d10, DT::kFLOAT, LinearLayer<2, d10, d2, DT::kFLOAT>, LinearLayer<2, d2, d10, DT::kFLOAT>>;
+    static_assert(std::tuple_size_v<Bottleneck::Lowered> == 2);
+
+    // Only identities - one is kept so the network still has a layer
+    static_assert(std::tuple_size_v<Sequential<2, d5, d5, DT::kFLOAT, I, I>::Lowered> == 1);
+
+    std::vector<float> w1(50), b1(5), w2(15), b2(3), x(20);
+    for (std::size_t i = 0; i < w1.size(); ++i) w1[i] = 0.05f * static_cast<float>(i % 7) - 0.1f;
+    for (std::size_t i = 0; i < w2.size(); ++i) w2[i] = 0.1f * static_cast<float>(i % 5) - 0.2f;
+    for (std::size_t i = 0; i < b1.size(); ++i) b1[i] = 0.3f - 0.1f * static_cast<float>(i);
+    for (std::size_t i = 0; i < b2.size(); ++i) b2[i] = 0.2f * static_cast<float>(i);
+    for (std::size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i % 9) - 4.f;
+
+    std::vector<float> expected(6), out(6);
+    for (int r = 0; r < 2; ++r)
+        for (int n = 0; n < 3; ++n) {
+            double acc = b2[n];
+            for (int h = 0; h < 5; ++h) {
+                double z = b1[h];
+                for (int k = 0; k < 10; ++k)
+                    z += static_cast<double>(x[r * 10 + k]) * w1[h * 10 + k];
+                acc += z * w2[n * 5 + h];
+            }
+            expected[r * 3 + n] = static_cast<float>(acc);
+        }
+
+    CpuExecutor<Merged> executor(Merged(L1(w1, b1), I(), L2(w2, b2)));
+    executor.run(x.data(), out.data());
+    for (int i = 0; i < 6; ++i)
+        assert(std::fabs(out[i] - expected[i]) < 1e-4f && "Folded weights mismatch.");
+
+    // TRT lowering: 2 constants + MatMul + bias add (+ activation) per lowered linear
+    DefaultLogger logger;
+    nvinfer1::IBuilder* builder = nvinfer1::createInferBuilder(logger);
+    trt_types::Network* network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
+    auto input = network->addInput("input", trt_types::DataType::kFLOAT, d10);
+    Fused fused;
+    network->markOutput(*fused.addToNetwork(network, input));
+    assert(network->getNbLayers() == 5 + 4 + 1 && "Unexpected lowered layer count.");
+    delete network;
+
+    network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
+    input = network->addInput("input", trt_types::DataType::kFLOAT, d10);
+    Merged merged;
+    network->markOutput(*merged.addToNetwork(network, input));
+    assert(network->getNbLayers() == 4 && "Linear chain should lower to a single linear.");
+    delete network;
+    delete builder;
+
+    std::cout << "Rewrite Test Passed!" << std::endl;
+}
+
+// Test Case for compile-time cost model and budgets
+void testCostModel() {
+    using DT = trt_types::DataType;
+    constexpr trt_types::Dims d10{2, {1, 10}}, d5{2, {1, 5}}, d3{2, {1, 3}};
+    using L1 = LinearLayer<2, d10, d5, DT::kFLOAT>;
+    using L2 = LinearLayer<2, d5, d3, DT::kFLOAT>;
+    using A = ActivationLayer<2, d5, DT::kFLOAT, trt_types::ActivationType::kRELU>;
+    using S = SoftmaxLayer<2, d3, DT::kFLOAT>;
+
+    static_assert(L1::cost().params == 55 && L1::cost().weight_bytes == 220);
+    static_assert(L1::cost().macs == 100 && L1::cost().flops == 2 * 100 + 10);
+    static_assert(L1::cost().activation_bytes == 2 * (10 + 5) * 4);
+    static_assert(LinearLayer<2, d10, d5, DT::kHALF>::cost().weight_bytes == 110, "fp16 parameters take 2 bytes.");
+    static_assert(A::cost().params == 0 && A::cost().flops == 10);
+    static_assert(IdentityLayer<2, d5, DT::kFLOAT>::cost().flops == 0);
+
+    // Sequential sums work of lowered children (Fused(L1, A), L2, S), activation peak is the widest step
+    using Model = Sequential<2, d10, d3, DT::kFLOAT, L1, A, L2, S>;
+    constexpr Cost c = Model::cost();
+    static_assert(c.params == 55 + 18 && c.weight_bytes == (55 + 18) * 4);
+    static_assert(c.macs == 100 + 30 && c.flops == (210 + 10) + (60 + 6) + 5 * 6);
+    static_assert(c.activation_bytes == L1::cost().activation_bytes);
+
+    // Folded chain does less work, parameters stay what bind() loads
+    using Folded = Sequential<2, d10, d3, DT::kFLOAT, L1, L2>;
+    static_assert(Folded::cost().params == 55 + 18 && Folded::cost().weight_bytes == (55 + 18) * 4 && Folded::cost().macs == 60);
+    using Wide = LinearLayer<2, trt_types::Dims{2, {1, 1000}}, trt_types::Dims{2, {1, 4}}, DT::kFLOAT>;
+    using Back = LinearLayer<2, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 1000}}, DT::kFLOAT>;
+    using Bottleneck = Sequential<2, trt_types::Dims{2, {1, 1000}}, trt_types::Dims{2, {1, 1000}}, DT::kFLOAT, Wide, Back>;
+    static_assert(Bottleneck::cost().params == 4004 + 5000 && "Folding a bottleneck must not inflate params.");
+
+    static_assert(check_budget<Model, Budget{.max_weight_bytes = 1024, .max_flops = 400}>::value);
+    static_assert(fits_budget<Model, Budget{.max_params = 100}>);
+    static_assert(!fits_budget<Model, Budget{.max_flops = 100}>);
+    static_assert(!fits_budget<Model, Budget{.max_activation_bytes = 64}>);
+
+    std::cout << "Cost Model Test Passed!" << std::endl;
+}
+
+// Whether [1 x 10] -> [1 x 5] Split accepts branches
+template<typename... Bs>
+concept ValidSplit = requires { typename Split<2, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT, 1, Bs...>; };
+
+// Test Case for Parallel/Split branches (compile-time checks, CPU concat and TRT lowering)
+void testBranches() {
+    using DT = trt_types::DataType;
+    constexpr trt_types::Dims d10{2, {1, 10}}, d6{2, {1, 6}}, d4{2, {1, 4}}, d3{2, {1, 3}}, d2{2, {1, 2}}, d5{2, {1, 5}};
+    using H1 = LinearLayer<2, d10, d3, DT::kFLOAT>;
+    using H2 = LinearLayer<2, d10, d2, DT::kFLOAT>;
+    using Heads = Parallel<2, d10, d5, DT::kFLOAT, 1, H1, H2>;
+
+    static_assert(concatDims(1, std::array{d3, d2}) == d5);
+    static_assert(concatDims(0, std::array{d3, d2}).nbDims == -1, "Mismatched non-axis dims must be rejected.");
+    static_assert(!check_branches<2, d5, DT::kFLOAT, 1, H1, LinearLayer<2, d10, d2, DT::kHALF>>::value, "Dtypes must match.");
+    static_assert(!check_branches<2, d10, DT::kFLOAT, 1, H1, H2>::value, "Output must be concatenation of branches.");
+    static_assert(!check_branches<4, d5, DT::kFLOAT, 1, H1, H2>::value, "Branches must cover batch range.");
+    static_assert(Heads::cost().params == H1::cost().params + H2::cost().params);
+
+    std::vector<float> w1(30), b1(3), w2(20), b2(2), x(20);
+    for (std::size_t i = 0; i < w1.size(); ++i) w1[i] = 0.1f * static_cast<float>(i % 7) - 0.3f;
+    for (std::size_t i = 0; i < w2.size(); ++i) w2[i] = 0.2f * static_cast<float>(i % 3) - 0.1f;
+    for (std::size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i % 5) - 2.f;
+    b1 = {0.1f, 0.2f, 0.3f};
+    b2 = {-1.f, 1.f};
+
+    // reference: y[r] = [x[r] W1^T + b1, x[r] W2^T + b2]
+    auto dense = [](const float* xr, const std::vector<float>& w, const std::vector<float>& b, int K, int n) {
+        double acc = b[n];
+        for (int k = 0; k < K; ++k)
+            acc += static_cast<double>(xr[k]) * w[n * K + k];
+        return static_cast<float>(acc);
+    };
+    std::vector<float> out(10);
+    CpuExecutor<Heads> heads(Heads(H1(w1, b1), H2(w2, b2)));
+    heads.run(x.data(), out.data());
+    for (int r = 0; r < 2; ++r) {
+        for (int n = 0; n < 3; ++n)
+            assert(std::fabs(out[r * 5 + n] - dense(&x[r * 10], w1, b1, 10, n)) < 1e-4f && "Parallel head 1 mismatch.");
+        for (int n = 0; n < 2; ++n)
+            assert(std::fabs(out[r * 5 + 3 + n] - dense(&x[r * 10], w2, b2, 10, n)) < 1e-4f && "Parallel head 2 mismatch.");
+    }
+
+    // Split: x[:, :6] -> [6 x 3], x[:, 6:] -> [4 x 2]
+    using S1 = LinearLayer<2, d6, d3, DT::kFLOAT>;
+    using S2 = LinearLayer<2, d4, d2, DT::kFLOAT>;
+    using Halves = Split<2, d10, d5, DT::kFLOAT, 1, S1, S2>;
+    static_assert(ValidSplit<S1, S2>);
+    static_assert(!ValidSplit<S1, LinearLayer<2, d6, d2, DT::kFLOAT>>, "Branch inputs must tile the input.");
+    std::vector<float> ws1(w1.begin(), w1.begin() + 18), ws2(w2.begin(), w2.begin() + 8);
+    CpuExecutor<Halves> halves(Halves(S1(ws1, b1), S2(ws2, b2)));
+    halves.run(x.data(), out.data());
+    for (int r = 0; r < 2; ++r) {
+        for (int n = 0; n < 3; ++n)
+            assert(std::fabs(out[r * 5 + n] - dense(&x[r * 10], ws1, b1, 6, n)) < 1e-4f && "Split branch 1 mismatch.");
+        for (int n = 0; n < 2; ++n)
+            assert(std::fabs(out[r * 5 + 3 + n] - dense(&x[r * 10 + 6], ws2, b2, 4, n)) < 1e-4f && "Split branch 2 mismatch.");
+    }
+
+    // Concat over outer axis interleaves whole rows per sample
+    constexpr trt_types::Dims r23{2, {2, 3}}, r13{2, {1, 3}}, r33{2, {3, 3}};
+    using Stack = Split<1, r33, r33, DT::kFLOAT, 0, IdentityLayer<1, r23, DT::kFLOAT>, ActivationLayer<1, r13, DT::kFLOAT, trt_types::ActivationType::kRELU>>;
+    std::vector<float> m{1, -2, 3, -4, 5, -6, -7, 8, -9}, stacked(9);
+    CpuExecutor<Stack>(Stack()).run(m.data(), stacked.data());
+    assert((stacked == std::vector<float>{1, -2, 3, -4, 5, -6, 0, 8, 0}));
+
+    // TRT: one network, branches joined by a single concatenation on the sample axis
+    DefaultLogger logger;
+    nvinfer1::IBuilder* builder = nvinfer1::createInferBuilder(logger);
+    trt_types::Network* network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
+    auto input = network->addInput("input", DT::kFLOAT, trt_types::Dims3{2, 1, 10});
+    Heads model;
+    network->markOutput(*model.addToNetwork(network, input));
+    assert(network->getNbLayers() == 2 * 4 + 1);
+    auto* concat = static_cast<nvinfer1::IConcatenationLayer*>(network->getLayer(network->getNbLayers() - 1));
+    assert(concat->getType() == nvinfer1::LayerType::kCONCATENATION && concat->getAxis() == 2);
+    delete network;
+
+    // dynamic batch slices get their size from a shape tensor
+    constexpr BatchSize range{1, 4, 8};
+    using DynHalves = Split<range, d10, d5, DT::kFLOAT, 1, LinearLayer<range, d6, d3, DT::kFLOAT>, LinearLayer<range, d4, d2, DT::kFLOAT>>;
+    network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
+    input = network->addInput("input", DT::kFLOAT, trt_types::Dims3{-1, 1, 10});
+    DynHalves dyn;
+    network->markOutput(*dyn.addToNetwork(network, input));
+    assert(network->getLayer(0)->getType() == nvinfer1::LayerType::kSLICE && network->getLayer(0)->getNbInputs() == 3);
+    delete network;
+    delete builder;
+
+    trttl::Network<DynHalves> net(logger);
+    assert(net.serialize() != nullptr);
+
+    std::cout << "Branches Test Passed!" << std::endl;
+}
+
+// Test Case for pack utilities, shape deduction and nested Sequential flattening
+void testScalableTemplates() {
+    using DT = trt_types::DataType;
+    constexpr trt_types::Dims d10{2, {1, 10}}, d5{2, {1, 5}}, d3{2, {1, 3}};
+    using L1 = LinearLayer<2, d10, d5, DT::kFLOAT>;
+    using L2 = LinearLayer<2, d5, d3, DT::kFLOAT>;
+    using A = ActivationLayer<2, d5, DT::kFLOAT, trt_types::ActivationType::kRELU>;
+    using S = SoftmaxLayer<2, d3, DT::kFLOAT>;
+
+    static_assert(std::is_same_v<cexpr_utils::nth<1, int, char, float>, char>);
+    static_assert(std::is_same_v<cexpr_utils::last<int, char, float>, float>);
+    static_assert(check_seq<L1, A, L2, S>::value && !check_seq<L1, L2, A>::value && check_seq<L1>::value);
+
+    // Only the input shape is written
+    using Auto = AutoSequential<2, d10, DT::kFLOAT, layers::Linear<5>, layers::Relu, layers::Linear<3>, layers::Softmax>;
+    static_assert(std::is_same_v<Auto, Sequential<2, d10, d3, DT::kFLOAT, L1, A, L2, S>>);
+    using Blocks = AutoSequential<2, d10, DT::kFLOAT, layers::Linear<5>, layers::Chain<layers::Relu, layers::Linear<3>>, layers::Use<S>>;
+    static_assert(Blocks::out_shape == d3);
+
+    // Nested Sequential is spliced in - Linear -> Activation fuses across the boundary
+    using Inner = Sequential<2, d5, d3, DT::kFLOAT, A, L2>;
+    using Nested = Sequential<2, d10, d3, DT::kFLOAT, L1, Inner, S>;
+    static_assert(std::is_same_v<Nested::Lowered, Auto::Lowered>);
+    static_assert(std::is_same_v<Blocks::Lowered, Auto::Lowered>);
+    static_assert(Nested::cost().flops == Auto::cost().flops);
+
+    std::vector<float> w1(50), b1(5, 0.1f), w2(15), b2(3, -0.2f), x(20);
+    for (std::size_t i = 0; i < w1.size(); ++i) w1[i] = 0.05f * static_cast<float>(i % 7) - 0.1f;
+    for (std::size_t i = 0; i < w2.size(); ++i) w2[i] = 0.1f * static_cast<float>(i % 5) - 0.2f;
+    for (std::size_t i = 0; i < x.size(); ++i) x[i] = static_cast<float>(i % 9) - 4.f;
+
+    std::vector<float> expected(6), out(6);
+    CpuExecutor<Auto>(Auto(L1(w1, b1), A(), L2(w2, b2), S())).run(x.data(), expected.data());
+    CpuExecutor<Nested>(Nested(L1(w1, b1), Inner(A(), L2(w2, b2)), S())).run(x.data(), out.data());
+    for (int i = 0; i < 6; ++i)
+        assert(std::fabs(out[i] - expected[i]) < 1e-6f && "Flattened Sequential mismatch.");
+
+    // Hash still follows listed modules - same leaves, same hash
+    const uint64_t flat = Auto(L1(w1, b1), A(), L2(w2, b2), S()).weightsHash();
+    assert(Nested(L1(w1, b1), Inner(A(), L2(w2, b2)), S()).weightsHash() == flat);
+
+    std::cout << "Scalable Templates Test Passed!" << std::endl;
+}
+
+// Collects layer names of a freshly built network
+template<typename M>
+std::vector<std::string> layerNames(M& m, const std::string& name) {
+    DefaultLogger logger;
+    std::unique_ptr<nvinfer1::IBuilder> builder(nvinfer1::createInferBuilder(logger));
+    std::unique_ptr<trt_types::Network> network(builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH)));
+    auto input = network->addInput("input", trt_types::DataType::kFLOAT, trt_types::Dims3{2, 1, 10});
+    network->markOutput(*m.addToNetwork(network.get(), input, name));
+    std::vector<std::string> names;
+    for (int32_t i = 0; i < network->getNbLayers(); ++i)
+        names.emplace_back(network->getLayer(i)->getName());
+    return names;
+}
+
+// Test Case for deterministic layer naming
+void testLayerNames() {
+    using DT = trt_types::DataType;
+    constexpr trt_types::Dims d10{2, {1, 10}}, d5{2, {1, 5}}, d3{2, {1, 3}}, d2{2, {1, 2}};
+    using L1 = LinearLayer<2, d10, d5, DT::kFLOAT>;
+    using L2 = LinearLayer<2, d5, d3, DT::kFLOAT>;
+    using A = ActivationLayer<2, d5, DT::kFLOAT, trt_types::ActivationType::kRELU>;
+    using S = SoftmaxLayer<2, d3, DT::kFLOAT>;
+    using Inner = Sequential<2, d5, d3, DT::kFLOAT, A, L2>;
+    using Nested = Sequential<2, d10, d3, DT::kFLOAT, L1, Inner, S>;
+
+    static_assert(L1::label() == "LinearLayer" && Nested::label() == "Sequential");
+
+    // Lowered layers are named after the listed children they came from
+    Nested model;
+    const auto names = layerNames(model, "model");
+    assert(names.size() == 5 + 4 + 1);
+    assert(names[0] == "model.0+model.1.0/FusedLinearLayer.0" && names[4] == "model.0+model.1.0/FusedLinearLayer.4");
+    assert(names[5] == "model.1.1/LinearLayer.0" && names[8] == "model.1.1/LinearLayer.3");
+    assert(names[9] == "model.2/SoftmaxLayer");
+    assert(layerNames(model, "model") == names && "Names should be deterministic.");
+
+    // Single layer module at the root keeps just its label
+    A relu;
+    DefaultLogger logger;
+    std::unique_ptr<nvinfer1::IBuilder> builder(nvinfer1::createInferBuilder(logger));
+    std::unique_ptr<trt_types::Network> network(builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH)));
+    relu.addToNetwork(network.get(), network->addInput("input", DT::kFLOAT, trt_types::Dims3{2, 1, 5}));
+    assert(std::string(network->getLayer(0)->getName()) == "ActivationLayer");
+
+    // Branches get `name.i`, slices and concat are named too
+    using Heads = Split<2, d10, d5, DT::kFLOAT, 1, LinearLayer<2, trt_types::Dims{2, {1, 6}}, d3, DT::kFLOAT>,
+                        LinearLayer<2, trt_types::Dims{2, {1, 4}}, d2, DT::kFLOAT>>;
+    Heads heads;
+    const auto branch_names = layerNames(heads, "");
+    assert(branch_names.front() == "0/Slice" && branch_names[1] == "0/LinearLayer.0");
+    assert(branch_names[5] == "1/Slice" && branch_names.back() == "Concat");
+
+    std::cout << "Layer Names Test Passed!" << std::endl;
+}
+
 int main() {
     try {
         testLinearLayerInitialization();
@@ -172,6 +546,13 @@ int main() {
         testSoftmaxLayerInitialization();
         testSoftmaxLayerAddToNetwork();
         testTensorRTEngine();
+        testZeroWeightCopies();
+        testDynamicBatch();
+        testRewrite();
+        testCostModel();
+        testBranches();
+        testScalableTemplates();
+        testLayerNames();
 
         std::cout << "All Tests Passed!" << std::endl;
     } catch (const std::exception& e) {
@@ -0,0 +1,252 @@
+#include "../include/trttl.h"
+#include <NvInfer.h>
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace trttl;
+
+using L1 = LinearLayer<1, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>;
+using L2 = LinearLayer<1, trt_types::Dims{2, {1, 5}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+template<trt_types::ActivationType at>
+using Act = ActivationLayer<1, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT, at>;
+template<trt_types::ActivationType at>
+using Model = Sequential<1, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT, L1, Act<at>, L2>;
+
+const std::filesystem::path cache_dir = "test_plan_cache";
+
+// Stub builder - counts invocations, returns deterministic plan
+struct StubBuilder {
+    int calls = 0;
+
+    Plan operator()() {
+        ++calls;
+        return Plan(1000, static_cast<char>(calls));
+    }
+};
+
+// Test Case for compile-time fingerprints
+void testFingerprint() {
+    static_assert(Model<trt_types::ActivationType::kRELU>::fingerprint() == Model<trt_types::ActivationType::kRELU>::fingerprint());
+    static_assert(Model<trt_types::ActivationType::kRELU>::fingerprint() != Model<trt_types::ActivationType::kTANH>::fingerprint(),
+                  "Activation type must change fingerprint.");
+    static_assert(L1::fingerprint() != L2::fingerprint(), "Shapes must change fingerprint.");
+    static_assert(LinearLayer<2, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>::fingerprint() != L1::fingerprint(),
+                  "Batch size must change fingerprint.");
+
+    Model<trt_types::ActivationType::kRELU> a;
+    Model<trt_types::ActivationType::kRELU> b(L1(std::vector<float>(50, 0.2f), std::vector<float>(5, 0.f)), {}, L2());
+    assert(a.weightsHash() != b.weightsHash() && "Weights must change hash.");
+    assert(Network<decltype(a)>::planKey(a) == Network<decltype(a)>::planKey(Model<trt_types::ActivationType::kRELU>()));
+
+    std::cout << "Fingerprint Test Passed!" << std::endl;
+}
+
+// Test Case for hit/miss behaviour with stub builder
+void testHitMiss() {
+    std::filesystem::remove_all(cache_dir);
+    PlanCache cache(cache_dir);
+    StubBuilder builder;
+
+    auto p1 = cache.getOrBuild(42, std::ref(builder));
+    auto p2 = cache.getOrBuild(42, std::ref(builder));
+    assert(builder.calls == 1 && "Hit should skip builder.");
+    assert(p1 == p2);
+    assert(cache.hits() == 1 && cache.misses() == 1);
+
+    PlanCache reopened(cache_dir);
+    assert(reopened.get(42).has_value() && "Entries should persist across instances.");
+
+    std::cout << "Hit/Miss Test Passed!" << std::endl;
+}
+
+// Test Case for corrupted entries being rejected
+void testCorruption() {
+    std::filesystem::remove_all(cache_dir);
+    PlanCache cache(cache_dir);
+    StubBuilder builder;
+    cache.getOrBuild(7, std::ref(builder));
+
+    for (const auto& e : std::filesystem::directory_iterator(cache_dir)) {
+        std::fstream f(e.path(), std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(-1, std::ios::end);
+        f.put('x');
+    }
+    assert(!cache.get(7).has_value() && "Checksum mismatch should be a miss.");
+    cache.getOrBuild(7, std::ref(builder));
+    assert(builder.calls == 2);
+
+    std::cout << "Corruption Test Passed!" << std::endl;
+}
+
+// Test Case for LRU eviction
+void testEviction() {
+    std::filesystem::remove_all(cache_dir);
+    PlanCache cache(cache_dir, 2500);
+    StubBuilder builder;
+
+    cache.getOrBuild(1, std::ref(builder));
+    cache.getOrBuild(2, std::ref(builder));
+    std::filesystem::last_write_time(cache_dir / "0000000000000001.plan",
+                                     std::filesystem::file_time_type::clock::now() + std::chrono::seconds(1));
+    cache.getOrBuild(3, std::ref(builder));
+
+    assert(cache.get(1).has_value() && "Recently used entry should survive.");
+    assert(!cache.get(2).has_value() && "Least recently used entry should be evicted.");
+    assert(cache.get(3).has_value());
+
+    std::cout << "Eviction Test Passed!" << std::endl;
+}
+
+// Test Case for Network serialization through cache
+void testNetworkCache() {
+    std::filesystem::remove_all(cache_dir);
+    DefaultLogger logger;
+    PlanCache cache(cache_dir);
+
+    Model<trt_types::ActivationType::kRELU> model;
+    {
+        trttl::Network network(logger, model);
+        auto plan = network.serialize(cache);
+        assert(!plan.empty());
+    }
+    {
+        trttl::Network network(logger, model);
+        auto plan = network.serialize(cache);
+        assert(cache.hits() == 1 && "Second build should hit the cache.");
+    }
+    // Static form probes before defining the network
+    auto plan = trttl::Network<decltype(model)>::serialize(logger, model, cache);
+    assert(cache.hits() == 2 && cache.misses() == 1 && !plan.empty());
+    plan = trttl::Network<L1>::serialize(logger, L1(), cache);
+    assert(cache.misses() == 2 && "A miss is counted once.");
+    assert(trttl::Network<L1>::serialize(logger, L1(), cache) == plan && cache.hits() == 3);
+    std::filesystem::remove_all(cache_dir);
+
+    std::cout << "Network Cache Test Passed!" << std::endl;
+}
+
+// Test Case for persistent timing cache shared across builds and concurrent builders
+void testTimingCache() {
+    const std::filesystem::path path = "test_timing.cache";
+    std::filesystem::remove(path);
+    DefaultLogger logger;
+    Model<trt_types::ActivationType::kRELU> model;
+
+    auto build = [&](TimingCache& cache, auto m) {
+        trttl::Network network(logger, m);
+        network.setTimingCache(&cache);
+        assert(network.serialize() != nullptr);
+        assert(network.builderConfig()->getTimingCache() != nullptr);
+    };
+
+    TimingCache cache(path);
+    build(cache, L1());
+    assert(cache.misses() == 1 && cache.hits() == 0 && std::filesystem::exists(path));
+    const auto small = std::filesystem::file_size(path);
+    build(cache, L1());
+    assert(cache.hits() == 1 && "Rebuild should be served from the cache.");
+    build(cache, model);
+    assert(cache.misses() == 2 && std::filesystem::file_size(path) > small && "New timings should be merged.");
+
+    // builders with separate handles merge into one file instead of overwriting
+    std::filesystem::remove(path);
+    {
+        TimingCache a(path), b(path);
+        std::thread ta([&] { for (int i = 0; i < 4; ++i) build(a, L1()); });
+        std::thread tb([&] { for (int i = 0; i < 4; ++i) build(b, model); });
+        ta.join();
+        tb.join();
+    }
+    TimingCache reopened(path);
+    build(reopened, L1());
+    build(reopened, model);
+    assert(reopened.hits() == 2 && reopened.misses() == 0 && "Entries of both builders should survive.");
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "garbage";
+    TimingCache corrupted(path);
+    build(corrupted, L1());
+    assert(corrupted.misses() == 1);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove("test_timing.cache.lock");
+
+    std::cout << "Timing Cache Test Passed!" << std::endl;
+}
+
+// Test Case for build policies and config recorded with cached plans
+void testBuildPolicy() {
+    using M = Model<trt_types::ActivationType::kRELU>;
+    static_assert(build_policies::dev.hash() != build_policies::prod.hash() && build_policies::standard.hash() != build_policies::dev.hash());
+    static_assert(BuildPolicy::mask(nvinfer1::TacticSource::kCUBLAS, nvinfer1::TacticSource::kCUDNN) == 0b101);
+    M model;
+    const uint64_t dev_key = Network<M, build_policies::dev>::planKey(model);
+    assert(dev_key != Network<M>::planKey(model) && "Policy must change plan key.");
+
+    DefaultLogger logger;
+    {
+        Network<M, build_policies::dev> dev(logger, model);
+        assert(dev.builderConfig()->getBuilderOptimizationLevel() == 0);
+        assert(dev.builderConfig()->getMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE) == (1ull << 30));
+        Network<M, build_policies::prod> prod(logger, model);
+        assert(prod.builderConfig()->getBuilderOptimizationLevel() == 5);
+    }
+
+    static constexpr BuildPolicy custom{
+        .name = "portable",
+        .tactic_sources = BuildPolicy::mask(nvinfer1::TacticSource::kCUBLAS_LT),
+        .preview_enable = BuildPolicy::mask(nvinfer1::PreviewFeature::kPROFILE_SHARING_0806),
+        .hardware_compatibility = nvinfer1::HardwareCompatibilityLevel::kAMPERE_PLUS};
+    Network<M, custom> network(logger, model);
+    auto* config = network.builderConfig();
+    assert(config->getTacticSources() == 0b10 && config->getPreviewFeature(nvinfer1::PreviewFeature::kPROFILE_SHARING_0806));
+    assert(config->getHardwareCompatibilityLevel() == nvinfer1::HardwareCompatibilityLevel::kAMPERE_PLUS);
+    config->setFlag(nvinfer1::BuilderFlag::kTF32);
+    const std::string json = network.configJson();
+    assert(json.rfind("{\"policy\": \"portable\", \"tensorrt\": \"", 0) == 0);
+    assert(json.find("\"tactic_sources\": 2, \"preview_features\": 4, \"hardware_compatibility\": 1, \"builder_flags\": 128}") != std::string::npos);
+
+    std::filesystem::remove_all(cache_dir);
+    PlanCache cache(cache_dir);
+    assert(!cache.config(network.planKey()));
+    network.serialize(cache);
+    assert(cache.config(network.planKey()) == json && "Config should be stored with the plan.");
+    assert(cache.get(network.planKey()).has_value());
+
+    // Pool builds use the policy of the submission
+    {
+        BuildPool pool(1);
+        pool.submit<build_policies::prod>(logger, model, {.name = "prod", .plan_cache = &cache}).get();
+    }
+    const auto prod = cache.config(Network<M, build_policies::prod>::planKey(model));
+    assert(prod && prod->find("\"policy\": \"prod\"") != std::string::npos && prod->find("\"optimization_level\": 5") != std::string::npos);
+
+    cache.put(9, "plan", 4);
+    assert(cache.config(9) == std::string() && "Entries without config are valid.");
+    std::filesystem::remove_all(cache_dir);
+
+    std::cout << "Build Policy Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testFingerprint();
+        testHitMiss();
+        testCorruption();
+        testEviction();
+        testNetworkCache();
+        testTimingCache();
+        testBuildPolicy();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "../include/trttl.h"
+#include <filesystem>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <cmath>
+
+using namespace trttl;
+
+// Test Case for fp16 conversion (SIMD matches scalar reference, rounding and specials)
+void testHalfConversion() {
+    assert(quant_utils::fp32_to_fp16(1.f) == 0x3C00);
+    assert(quant_utils::fp32_to_fp16(-2.f) == 0xC000);
+    assert(quant_utils::fp32_to_fp16(65504.f) == 0x7BFF);
+    assert(quant_utils::fp32_to_fp16(65536.f) == 0x7C00 && "Overflow should saturate to inf.");
+    assert(quant_utils::fp32_to_fp16(1.f + 0x1.0p-11f) == 0x3C00 && "Tie should round to even.");
+    assert(quant_utils::fp32_to_fp16(0x1.0p-24f) == 0x0001 && "Smallest subnormal.");
+    assert(quant_utils::fp16_to_fp32(0x0001) == 0x1.0p-24f);
+    assert((quant_utils::fp32_to_fp16(std::numeric_limits<float>::quiet_NaN()) & 0x7FFF) > 0x7C00);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dist(-70000.f, 70000.f);
+    std::vector<float> x(1003);
+    for (auto& v : x)
+        v = dist(gen) * (gen() % 2 ? 1.f : 1e-6f);
+    x[5] = std::numeric_limits<float>::infinity();
+    x[17] = std::numeric_limits<float>::quiet_NaN();
+
+    std::vector<uint16_t> h(x.size());
+    quant_utils::to_fp16(x.data(), h.data(), x.size());
+    std::vector<float> back(x.size());
+    quant_utils::from_fp16(h.data(), back.data(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (std::isnan(x[i])) {
+            assert(std::isnan(back[i]));
+            continue;
+        }
+        assert(h[i] == quant_utils::fp32_to_fp16(x[i]) && "SIMD fp16 conversion mismatch.");
+        assert(back[i] == quant_utils::fp16_to_fp32(h[i]) && "SIMD fp16 widening mismatch.");
+    }
+
+    std::cout << "Half Conversion Test Passed!" << std::endl;
+}
+
+using HalfLinear = LinearLayer<2, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kHALF>;
+using Int8Linear = LinearLayer<BatchSize{1, 2, 4}, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kINT8>;
+
+// Test Case for reduced-precision parameters and builder flags
+void testPrecisionNetwork() {
+    DefaultLogger logger;
+
+    std::vector<float> w(12, 0.25f), b{1.f, 2.f, 3.f};
+    HalfLinear half(w, b);
+    assert(half.weights().type() == trt_types::DataType::kHALF && half.weights().bytes() == 24);
+    assert(static_cast<const uint16_t*>(half.biases().data())[2] == quant_utils::fp32_to_fp16(3.f));
+
+    trttl::Network<HalfLinear> half_net(logger, half);
+    assert(half_net.builderConfig()->getFlag(nvinfer1::BuilderFlag::kFP16));
+    assert(!half_net.builderConfig()->getFlag(nvinfer1::BuilderFlag::kINT8));
+
+    Int8Linear int8(w, b);
+    assert(int8.weights().type() == trt_types::DataType::kFLOAT && "INT8 layers keep fp32 weights for implicit quantization.");
+    trttl::Network<Int8Linear> int8_net(logger, int8);
+    auto* config = int8_net.builderConfig();
+    assert(config->getFlag(nvinfer1::BuilderFlag::kINT8) && config->getFlag(nvinfer1::BuilderFlag::kFP16));
+    assert(config->getCalibrationProfile() != nullptr && "Dynamic INT8 network needs calibration profile.");
+
+    StreamingCalibrator<Int8Linear> calibrator({});
+    int8_net.setCalibrator(&calibrator);
+    assert(config->getInt8Calibrator() == &calibrator);
+    auto plan = int8_net.serialize();
+    assert(plan != nullptr);
+
+    std::cout << "Precision Network Test Passed!" << std::endl;
+}
+
+// Test Case for streaming calibration batches across raw and .npy files
+void testCalibrator() {
+    // 3 samples in raw file, 2 in .npy - batches of kOPT = 2 rows x 4 floats
+    std::vector<float> samples(5 * 4);
+    for (std::size_t i = 0; i < samples.size(); ++i)
+        samples[i] = static_cast<float>(i);
+    {
+        std::ofstream raw("test_calib.bin", std::ios::binary);
+        raw.write(reinterpret_cast<const char*>(samples.data()), 12 * sizeof(float));
+
+        std::string header = "{'descr': '<f4', 'fortran_order': False, 'shape': (2, 4), }";
+        header.append(64 - (10 + header.size() + 1) % 64, ' ');
+        header += '\n';
+        std::ofstream npy("test_calib.npy", std::ios::binary);
+        npy.write("\x93NUMPY\x01\x00", 8);
+        const uint16_t len = static_cast<uint16_t>(header.size());
+        npy.write(reinterpret_cast<const char*>(&len), 2);
+        npy << header;
+        npy.write(reinterpret_cast<const char*>(samples.data() + 12), 8 * sizeof(float));
+    }
+    std::filesystem::remove("test_calib.cache");
+
+    StreamingCalibrator<Int8Linear> calibrator({"test_calib.bin", "test_calib.npy"}, "test_calib.cache");
+    static_assert(StreamingCalibrator<Int8Linear>::batch_floats == 8);
+    std::size_t len = 1;
+    assert(calibrator.readCalibrationCache(len) == nullptr && len == 0);
+
+    void* bindings[1] = {nullptr};
+    const char* names[1] = {"input"};
+    for (int batch = 0; batch < 2; ++batch) {
+        assert(calibrator.getBatch(bindings, names, 1) && "Expected full batch.");
+        std::vector<float> got(8);
+        cudaMemcpy(got.data(), bindings[0], 8 * sizeof(float), cudaMemcpyDeviceToHost);
+        for (int i = 0; i < 8; ++i)
+            assert(got[i] == samples[batch * 8 + i] && "Batch should continue across files.");
+    }
+    assert(!calibrator.getBatch(bindings, names, 1) && "Trailing partial batch should be skipped.");
+    assert(calibrator.batches() == 2);
+    assert(!calibrator.error() && "Clean run should record no error.");
+
+    const char table[] = "TRT-8601-EntropyCalibration2\ninput: 3c010a14\n";
+    calibrator.writeCalibrationCache(table, sizeof(table));
+    StreamingCalibrator<Int8Linear> cached({}, "test_calib.cache");
+    const void* data = cached.readCalibrationCache(len);
+    assert(len == sizeof(table) && std::memcmp(data, table, len) == 0 && "Calibration cache should round-trip.");
+
+    // Invalid inputs are rejected up front instead of ending calibration silently
+    bool thrown = false;
+    try { StreamingCalibrator<Int8Linear> missing({"test_calib_missing.bin"}); } catch (const std::ios_base::failure&) { thrown = true; }
+    assert(thrown && "Missing calibration file should be rejected.");
+    {
+        std::ofstream odd("test_calib_odd.bin", std::ios::binary);
+        odd.write("\0\0\0\0\0", 5);
+    }
+    thrown = false;
+    try { StreamingCalibrator<Int8Linear> odd({"test_calib_odd.bin"}); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && "Partial float should be rejected.");
+    {
+        std::string header = "{'descr': '<f8', 'fortran_order': False, 'shape': (1,), }";
+        header.append(64 - (10 + header.size() + 1) % 64, ' ');
+        header += '\n';
+        std::ofstream npy("test_calib_f8.npy", std::ios::binary);
+        npy.write("\x93NUMPY\x01\x00", 8);
+        const uint16_t len = static_cast<uint16_t>(header.size());
+        npy.write(reinterpret_cast<const char*>(&len), 2);
+        npy << header;
+        npy.write("\0\0\0\0\0\0\0\0", 8);
+    }
+    thrown = false;
+    try { StreamingCalibrator<Int8Linear> f8({"test_calib.bin", "test_calib_f8.npy"}); } catch (const std::runtime_error&) { thrown = true; }
+    assert(thrown && "Non-<f4 .npy should be rejected.");
+
+    std::filesystem::remove("test_calib.bin");
+    std::filesystem::remove("test_calib.npy");
+    std::filesystem::remove("test_calib_odd.bin");
+    std::filesystem::remove("test_calib_f8.npy");
+    std::filesystem::remove("test_calib.cache");
+
+    std::cout << "Calibrator Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testHalfConversion();
+        testPrecisionNetwork();
+        testCalibrator();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
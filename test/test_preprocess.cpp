@@ -0,0 +1,118 @@
+#include "../include/trttl.h"
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <array>
+#include <cmath>
+
+using namespace trttl;
+
+using Image3 = IdentityLayer<2, trt_types::Dims{3, {3, 37, 41}}, trt_types::DataType::kFLOAT>;
+using Gray = IdentityLayer<1, trt_types::Dims{3, {1, 9, 13}}, trt_types::DataType::kHALF>;
+using Flat = IdentityLayer<1, trt_types::Dims{2, {1, 10}}, trt_types::DataType::kFLOAT>;
+using Ints = IdentityLayer<1, trt_types::Dims{3, {3, 4, 4}}, trt_types::DataType::kINT32>;
+
+template<typename M>
+concept Preprocessable = requires { typename Preprocessor<M>; };
+
+static_assert(Preprocessable<Image3> && Preprocessable<Gray>);
+static_assert(!Preprocessable<Flat> && !Preprocessable<Ints>, "Shape and dtype are checked against the module.");
+
+std::vector<uint8_t> randomImage(std::size_t n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::vector<uint8_t> v(n);
+    for (auto& x : v)
+        x = static_cast<uint8_t>(dist(gen));
+    return v;
+}
+
+// Naive HWC -> CHW reference
+template<typename P>
+std::vector<float> reference(const std::vector<uint8_t>& image, const std::array<float, P::channels>& mean,
+                             const std::array<float, P::channels>& stddev) {
+    std::vector<float> r(P::sample_size);
+    for (std::size_t c = 0; c < P::channels; ++c)
+        for (std::size_t i = 0; i < P::pixels; ++i)
+            r[c * P::pixels + i] = (static_cast<float>(image[i * P::channels + c]) - mean[c]) / stddev[c];
+    return r;
+}
+
+template<typename P>
+void check(const std::vector<uint8_t>& image, const std::vector<float>& expected, const P& pre) {
+    std::vector<float> out(P::sample_size, -1.f);
+    pre.run(typename P::Image(image.data(), P::image_size), typename P::Sample(out.data(), P::sample_size));
+    for (std::size_t i = 0; i < out.size(); ++i)
+        assert(std::fabs(out[i] - expected[i]) < 1e-5f * (1.f + std::fabs(expected[i])) && "Preprocessing mismatch.");
+}
+
+// Test Case for every enabled instruction set against the naive reference (odd sizes exercise tails)
+void testKernels() {
+    constexpr std::array<float, 3> mean{123.675f, 116.28f, 103.53f}, stddev{58.395f, 57.12f, 57.375f};
+    const auto image = randomImage(Preprocessor<Image3>::image_size, 1);
+    const auto expected = reference<Preprocessor<Image3>>(image, mean, stddev);
+
+    check(image, expected, Preprocessor<Image3, simd_utils::Scalar>(mean, stddev));
+    check(image, expected, Preprocessor<Image3>(mean, stddev));
+#if defined(__AVX2__) && defined(__FMA__)
+    check(image, expected, Preprocessor<Image3, simd_utils::Avx2>(mean, stddev));
+#endif
+#if defined(__AVX512F__)
+    check(image, expected, Preprocessor<Image3, simd_utils::Avx512>(mean, stddev));
+#endif
+
+    // Single channel takes the contiguous load path
+    const auto gray = randomImage(Preprocessor<Gray>::image_size, 2);
+    check(gray, reference<Preprocessor<Gray>>(gray, {0.f}, {255.f}), Preprocessor<Gray>());
+    check(gray, reference<Preprocessor<Gray>>(gray, {0.f}, {255.f}), Preprocessor<Gray, simd_utils::Scalar>());
+
+    std::cout << "Preprocess Kernels Test Passed! (" << simd_utils::Native::name << ")" << std::endl;
+}
+
+// Test Case for writing into batch slots - directly and through the batcher
+void testBatchSlots() {
+    using P = Preprocessor<Image3>;
+    const P pre({10.f, 20.f, 30.f}, {2.f, 4.f, 8.f});
+    const auto image = randomImage(P::image_size, 3);
+    const auto expected = reference<P>(image, {10.f, 20.f, 30.f}, {2.f, 4.f, 8.f});
+
+    auto batch = std::make_unique<InputBuffer<Image3>>();
+    std::fill(batch->begin(), batch->end(), 7.f);
+    pre.run(P::Image(image.data(), P::image_size), *batch, 1);
+    for (std::size_t i = 0; i < P::sample_size; ++i)
+        assert(batch->sample(0)[i] == 7.f && std::fabs(batch->sample(1)[i] - expected[i]) < 1e-5f * (1.f + std::fabs(expected[i])));
+
+    auto echo = [](const float* in, float* out, int32_t n) { std::copy(in, in + n * P::sample_size, out); };
+    Batcher<Image3, decltype(echo)> batcher(echo, std::chrono::microseconds(200));
+
+    bool thrown = false;
+    try {
+        batcher.submit([](std::span<float, P::sample_size>) { throw std::runtime_error("decode failed"); });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && batcher.metrics().queue_depth == 0 && "Failed fill should not enqueue.");
+
+    auto result = batcher.submit(pre.fill(P::Image(image.data(), P::image_size))).get();
+    for (std::size_t i = 0; i < P::sample_size; ++i)
+        assert(std::fabs(result[i] - expected[i]) < 1e-5f * (1.f + std::fabs(expected[i])));
+
+    std::cout << "Batch Slots Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testKernels();
+        testBatchSlots();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "../include/trttl.h"
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cmath>
+
+using namespace trttl;
+
+// Test Case for histogram bucketing
+void testHistogramBuckets() {
+    static_assert(LatencyHistogram::bucketOf(63) == 63 && LatencyHistogram::bucketOf(64) == 64);
+    static_assert(LatencyHistogram::bucketOf(uint64_t{1} << 50) == LatencyHistogram::bucket_count - 1, "Large values saturate.");
+    for (uint64_t v = 0; v < (uint64_t{1} << 24); v = v * 5 / 4 + 1) {
+        const std::size_t b = LatencyHistogram::bucketOf(v);
+        assert(b < LatencyHistogram::bucket_count);
+        assert(LatencyHistogram::lowerBound(b) <= v && v < LatencyHistogram::lowerBound(b) + LatencyHistogram::width(b));
+        assert(LatencyHistogram::width(b) <= std::max<uint64_t>(1, v / 32) && "Relative error should stay ~3%.");
+    }
+
+    LatencyHistogram h;
+    assert(h.percentile(0.5) == 0 && "Empty histogram.");
+    for (uint64_t us = 1; us <= 1000; ++us)
+        h.record(us * 1000);
+    assert(h.count() == 1000 && h.maxNs() == 1000000);
+    assert(std::fabs(static_cast<double>(h.percentile(0.5)) - 500000.0) < 500000.0 * 0.03);
+    assert(std::fabs(static_cast<double>(h.percentile(0.99)) - 990000.0) < 990000.0 * 0.03);
+    assert(h.percentile(1.0) == 1000000 && "Capped by max.");
+
+    std::cout << "Histogram Buckets Test Passed!" << std::endl;
+}
+
+// Test Case for per-layer aggregation and export fed by synthetic reports
+void testLayerProfiler() {
+    LayerProfiler profiler;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&profiler] {
+            for (int i = 0; i < 10000; ++i) {
+                profiler.reportLayerTime("model.0+model.1/FusedLinearLayer.2", 0.25f);
+                profiler.reportLayerTime("model.2/SoftmaxLayer", 0.001f * static_cast<float>(i % 100 + 1));
+            }
+        });
+    for (auto& t : threads)
+        t.join();
+    profiler.reportLayerTime("weird \"name\"", 1.0f);
+
+    const auto stats = profiler.stats();
+    assert(stats.size() == 3 && profiler.dropped() == 0);
+    assert(stats[0].name == "model.0+model.1/FusedLinearLayer.2" && stats[1].name == "model.2/SoftmaxLayer" && "Sorted by name.");
+    assert(stats[0].count == 40000 && stats[1].count == 40000);
+    assert(std::fabs(stats[0].p50_ms - 0.25) < 0.25 * 0.03 && std::fabs(stats[0].mean_ms - 0.25) < 1e-6);
+    assert(std::fabs(stats[1].p50_ms - 0.05) < 0.05 * 0.03 && std::fabs(stats[1].p99_ms - 0.099) < 0.099 * 0.03);
+    assert(stats[1].p999_ms <= stats[1].max_ms && std::fabs(stats[1].max_ms - 0.1) < 1e-6);
+    assert(profiler.histogram("model.2/SoftmaxLayer")->count() == 40000 && !profiler.histogram("missing"));
+
+    std::ostringstream json;
+    profiler.writeJson(json);
+    assert(json.str().find("{\"name\": \"model.2/SoftmaxLayer\", \"count\": 40000, ") != std::string::npos);
+    assert(json.str().find("\"weird \\\"name\\\"\"") != std::string::npos && "Names should be escaped.");
+
+    std::ostringstream prom;
+    profiler.writePrometheus(prom);
+    assert(prom.str().rfind("# HELP trttl_layer_latency_seconds ", 0) == 0);
+    assert(prom.str().find("trttl_layer_latency_seconds{layer=\"model.0+model.1/FusedLinearLayer.2\",quantile=\"0.99\"} ") != std::string::npos);
+    assert(prom.str().find("trttl_layer_latency_seconds_count{layer=\"model.2/SoftmaxLayer\"} 40000\n") != std::string::npos);
+
+    // Full table drops reports instead of blocking
+    LayerProfiler small(1);
+    for (int i = 0; i < 10; ++i)
+        small.reportLayerTime(("layer" + std::to_string(i)).c_str(), 1.0f);
+    assert(small.stats().size() == 4 && small.dropped() == 6);
+
+    std::ostringstream empty;
+    LayerProfiler().writeJson(empty);
+    assert(empty.str() == "{\"layers\": []}\n");
+
+    std::cout << "Layer Profiler Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testHistogramBuckets();
+        testLayerProfiler();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#ifndef TRTTL_TRACING
+#define TRTTL_TRACING
+#endif
+#include "../include/trttl.h"
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <set>
+
+using namespace trttl;
+
+using L1 = LinearLayer<2, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT>;
+using L2 = LinearLayer<2, trt_types::Dims{2, {1, 5}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+using Act = ActivationLayer<2, trt_types::Dims{2, {1, 5}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+using Model = Sequential<2, trt_types::Dims{2, {1, 10}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT, L1, Act, L2>;
+
+struct Span {
+    uint32_t tid;
+    TraceEvent event;
+};
+
+std::vector<Span> spans() {
+    std::vector<Span> r;
+    Tracer::for_each([&](uint32_t tid, const TraceEvent& e) { r.push_back({tid, e}); });
+    return r;
+}
+
+const Span& find(const std::vector<Span>& all, std::string_view name, std::string_view detail = {}) {
+    for (const auto& s : all)
+        if (s.event.name == name && (detail.empty() || s.event.detail == detail))
+            return s;
+    throw std::runtime_error("Missing span: " + std::string(name));
+}
+
+bool within(const Span& inner, const Span& outer) {
+    return inner.tid == outer.tid && outer.event.start_ns <= inner.event.start_ns &&
+           inner.event.start_ns + inner.event.duration_ns <= outer.event.start_ns + outer.event.duration_ns;
+}
+
+// Test Case for spans around network definition, build and plan caching
+void testBuildSpans() {
+    static_assert(tracing_enabled);
+    DefaultLogger logger;
+    Tracer::clear();
+
+    const auto dir = std::filesystem::temp_directory_path() / "trttl_tracing_cache";
+    std::filesystem::remove_all(dir);
+    {
+        PlanCache cache(dir);
+        trttl::Network<Model> network(logger);
+        network.serialize(cache);
+    }
+    std::filesystem::remove_all(dir);
+
+    const auto all = spans();
+    const Span& build = find(all, "Network::build");
+    const Span& model = find(all, "Sequential");
+    assert(build.event.category == "define" && within(find(all, "Network::configure"), build));
+    assert(within(model, build) && "Module spans nest in network definition.");
+    assert(within(find(all, "Sequential::lowered"), find(all, "Network::intern")) && "Lowered once, when parameters are interned.");
+    assert(within(find(all, "Network::intern"), build) && within(find(all, "FusedLinearLayer", "0+1"), model));
+    assert(within(find(all, "LinearLayer", "2"), model));
+    assert(find(all, "IBuilder::buildSerializedNetwork").event.category == "build");
+    assert(find(all, "PlanCache::get").event.category == "serialize" && find(all, "PlanCache::put").event.category == "serialize");
+
+    std::cout << "Build Spans Test Passed!" << std::endl;
+}
+
+// Test Case for per-thread buffers and Chrome trace export
+void testChromeTrace() {
+    DefaultLogger logger;
+    Tracer::clear();
+    {
+        BuildPool pool(2);
+        std::vector<BuildJob> jobs;
+        for (int i = 0; i < 4; ++i)
+            jobs.push_back(pool.submit(logger, Model(), {.name = "job" + std::to_string(i)}));
+        for (auto& j : jobs)
+            j.get();
+    }
+
+    const auto all = spans();
+    std::set<uint32_t> threads;
+    for (int i = 0; i < 4; ++i) {
+        const Span& job = find(all, "BuildPool::job", "job" + std::to_string(i));
+        bool built = false;
+        for (const auto& s : all)
+            built = built || (s.event.name == "IBuilder::buildSerializedNetwork" && within(s, job));
+        assert(built && "Build should nest in its job on the same thread.");
+        threads.insert(job.tid);
+    }
+    assert(!threads.empty() && threads.size() <= 2 && "Jobs should be recorded on pool threads.");
+    assert(Tracer::size() == all.size());
+
+    std::ostringstream out;
+    Tracer::write(out);
+    const std::string json = out.str();
+    assert(json.rfind("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n  {\"ph\": \"X\", \"pid\": 1, \"tid\": ", 0) == 0);
+    assert(json.find("\"cat\": \"job\", \"name\": \"BuildPool::job\", \"args\": {\"detail\": \"job3\"}}") != std::string::npos);
+    assert(json.size() > 3 && json.substr(json.size() - 3) == "]}\n");
+
+    const auto path = std::filesystem::temp_directory_path() / "trttl_trace.json";
+    Tracer::write(path);
+    std::ifstream fin(path);
+    assert(std::string(std::istreambuf_iterator<char>(fin), std::istreambuf_iterator<char>()) == json);
+    std::filesystem::remove(path);
+
+    Tracer::clear();
+    assert(Tracer::size() == 0);
+    std::ostringstream empty;
+    Tracer::write(empty);
+    assert(empty.str() == "{\"displayTimeUnit\": \"ms\", \"traceEvents\": []}\n");
+
+    std::cout << "Chrome Trace Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testBuildSpans();
+        testChromeTrace();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,291 @@
+#include "../include/trttl.h"
+#include <NvInfer.h>
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace trttl;
+
+using Linear1 = LinearLayer<1, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kFLOAT>;
+using Linear2 = LinearLayer<1, trt_types::Dims{2, {1, 3}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT>;
+using Relu = ActivationLayer<1, trt_types::Dims{2, {1, 3}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+using Model = Sequential<1, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 2}}, trt_types::DataType::kFLOAT, Linear1, Relu, Linear2>;
+using Square = LinearLayer<1, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 4}}, trt_types::DataType::kFLOAT>;
+using Relu4 = ActivationLayer<1, trt_types::Dims{2, {1, 4}}, trt_types::DataType::kFLOAT, trt_types::ActivationType::kRELU>;
+using Tied = Sequential<1, trt_types::Dims{2, {1, 4}}, trt_types::Dims{2, {1, 4}}, trt_types::DataType::kFLOAT, Square, Relu4, Square>;
+
+struct Entry {
+    std::string name;
+    std::string dtype;
+    std::vector<int64_t> shape;
+    std::vector<float> values;
+};
+
+// Writes minimal safetensors file
+void writeSafetensors(const std::string& path, const std::vector<Entry>& entries) {
+    std::string header = "{\"__metadata__\":{\"format\":\"pt\"}";
+    std::size_t offset = 0;
+    for (const auto& e : entries) {
+        header += ",\"" + e.name + "\":{\"dtype\":\"" + e.dtype + "\",\"shape\":[";
+        for (std::size_t i = 0; i < e.shape.size(); ++i)
+            header += (i ? "," : "") + std::to_string(e.shape[i]);
+        const std::size_t bytes = e.values.size() * sizeof(float);
+        header += "],\"data_offsets\":[" + std::to_string(offset) + "," + std::to_string(offset + bytes) + "]}";
+        offset += bytes;
+    }
+    header += "}";
+    while (header.size() % 8)
+        header += ' ';
+
+    std::ofstream f(path, std::ios::binary);
+    uint64_t len = header.size();
+    f.write(reinterpret_cast<const char*>(&len), 8);
+    f.write(header.data(), header.size());
+    for (const auto& e : entries)
+        f.write(reinterpret_cast<const char*>(e.values.data()), e.values.size() * sizeof(float));
+}
+
+// Writes v1 .npy file with float32 payload
+void writeNpy(const std::string& path, const std::vector<int64_t>& shape, const std::vector<float>& values) {
+    std::string dict = "{'descr': '<f4', 'fortran_order': False, 'shape': (";
+    for (auto s : shape)
+        dict += std::to_string(s) + ", ";
+    dict += "), }";
+    while ((10 + dict.size() + 1) % 64)
+        dict += ' ';
+    dict += '\n';
+
+    std::ofstream f(path, std::ios::binary);
+    f.write("\x93NUMPY\x01\x00", 8);
+    uint16_t len = dict.size();
+    f.write(reinterpret_cast<const char*>(&len), 2);
+    f.write(dict.data(), dict.size());
+    f.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+}
+
+// Test safetensors header parsing & zero-copy views
+void testSafetensorsLoad() {
+    writeSafetensors("test_weights.safetensors", {
+        {"0.weight", "F32", {4, 3}, std::vector<float>(12, 0.5f)},
+        {"0.bias", "F32", {3}, {1.f, 2.f, 3.f}},
+    });
+
+    Checkpoint ckpt;
+    ckpt.addSafetensors("test_weights.safetensors");
+    assert(ckpt.size() == 2);
+
+    const auto& b = ckpt.get("0.bias");
+    assert(b.type == trt_types::DataType::kFLOAT);
+    assert(b.shape.size() == 1 && b.shape[0] == 3);
+    assert(static_cast<const float*>(b.data)[2] == 3.f);
+    assert(b.data >= b.owner->data() && b.data < b.owner->data() + b.owner->size() && "View must point into mapping.");
+
+    std::cout << "Safetensors Load Test Passed!" << std::endl;
+}
+
+// Test .npy header parsing
+void testNpyLoad() {
+    writeNpy("test_weights.npy", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+
+    Checkpoint ckpt;
+    ckpt.addNpy("test_weights.npy", "2.weight");
+    const auto& w = ckpt.get("2.weight", trt_types::DataType::kFLOAT, {3, 2});
+    assert(w.count() == 6);
+    assert(static_cast<const float*>(w.data)[5] == 6.f);
+
+    std::cout << "Npy Load Test Passed!" << std::endl;
+}
+
+// Test binding validates shapes and dtypes
+void testBindValidation() {
+    writeSafetensors("test_weights_bad.safetensors", {
+        {"fc.weight", "F32", {4, 3}, std::vector<float>(12, 0.5f)},
+        {"fc.bias", "F32", {3}, {1.f, 2.f, 3.f}},
+        {"int.weight", "I32", {6}, std::vector<float>(6, 0.f)},
+        {"int.bias", "F32", {2}, {1.f, 2.f}},
+    });
+
+    Checkpoint ckpt;
+    ckpt.addSafetensors("test_weights_bad.safetensors");
+
+    Linear1 layer;
+    bool thrown = false;
+    try {
+        layer.bind(ckpt, "fc");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && "[in, out] weight shape should be rejected.");
+
+    thrown = false;
+    try {
+        Linear2 integer;
+        integer.bind(ckpt, "int");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && "Mismatched dtype should be rejected.");
+
+    thrown = false;
+    try {
+        layer.bind(ckpt, "missing");
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && "Missing tensor should be rejected.");
+
+    std::cout << "Bind Validation Test Passed!" << std::endl;
+}
+
+// Test PyTorch `nn.Linear` layout - `[out, in]` weights compute `x * W^T + b`
+void testBindLayout() {
+    std::vector<float> w(12);
+    for (std::size_t i = 0; i < w.size(); ++i)
+        w[i] = static_cast<float>(i);
+    writeSafetensors("test_weights_layout.safetensors", {
+        {"fc.weight", "F32", {3, 4}, w},
+        {"fc.bias", "F32", {3}, {1.f, 2.f, 3.f}},
+    });
+    Checkpoint ckpt;
+    ckpt.addSafetensors("test_weights_layout.safetensors");
+
+    Linear1 layer;
+    layer.bind(ckpt, "fc");
+    assert(layer.weights().data() == ckpt.get("fc.weight").data && "Bound weights should stay mapped.");
+    const float x[4] = {1.f, 2.f, 3.f, 4.f};
+    float y[3];
+    CpuExecutor<Linear1>(layer).run(x, y);
+    assert(y[0] == 1.f + 20.f && y[1] == 2.f + 60.f && y[2] == 3.f + 100.f);
+
+    std::cout << "Bind Layout Test Passed!" << std::endl;
+}
+
+// Test mapped pointers reach TRT weights without copy
+void testBoundNetwork() {
+    DefaultLogger logger;
+
+    writeSafetensors("test_weights.safetensors", {
+        {"0.weight", "F32", {3, 4}, std::vector<float>(12, 0.5f)},
+        {"0.bias", "F32", {3}, {1.f, 2.f, 3.f}},
+    });
+    Checkpoint ckpt;
+    ckpt.addSafetensors("test_weights.safetensors");
+    writeNpy("test_weights_w.npy", {2, 3}, std::vector<float>(6, 0.25f));
+    writeNpy("test_weights_b.npy", {1, 2}, {0.f, 1.f});
+    ckpt.addNpy("test_weights_w.npy", "2.weight");
+    ckpt.addNpy("test_weights_b.npy", "2.bias");
+
+    Model model;
+    model.bind(ckpt, "");
+
+    nvinfer1::IBuilder* builder = nvinfer1::createInferBuilder(logger);
+    trt_types::Network* network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
+    auto input = network->addInput("input", trt_types::DataType::kFLOAT, trt_types::Dims3{1, 1, 4});
+    network->markOutput(*model.addToNetwork(network, input));
+
+    auto* w_const = static_cast<nvinfer1::IConstantLayer*>(network->getLayer(0));
+    assert(w_const->getType() == nvinfer1::LayerType::kCONSTANT);
+    assert(w_const->getWeights().values == ckpt.get("0.weight").data && "Weights should be passed without copy.");
+    assert(w_const->getWeights().count == 12);
+
+    delete network;
+    delete builder;
+
+    trttl::Network net(logger, model, ckpt);
+    auto buffer = net.serialize();
+
+    std::cout << "Bound Network Test Passed!" << std::endl;
+}
+
+// Test Case for blob hash and content-addressed weight sharing
+void testWeightDedup() {
+    std::vector<float> blob(1000);
+    for (std::size_t i = 0; i < blob.size(); ++i)
+        blob[i] = static_cast<float>(i) * 0.5f;
+    const auto copy = blob;
+    const std::size_t bytes = blob.size() * sizeof(float);
+    assert(hash_utils::hash_blob(blob.data(), bytes) == hash_utils::hash_blob(copy.data(), bytes));
+    assert(hash_utils::hash_blob(blob.data(), bytes) != hash_utils::hash_blob(blob.data(), bytes, 1) && "Seeded.");
+    assert(hash_utils::hash_blob(blob.data(), 40) == hash_utils::hash_bytes(blob.data(), 40) && "Short blobs.");
+    for (std::size_t len : {64ul, 1024ul, 1028ul, bytes}) {
+        auto changed = blob;
+        reinterpret_cast<unsigned char*>(changed.data())[len - 1] ^= 1;
+        assert(hash_utils::hash_blob(blob.data(), len) != hash_utils::hash_blob(changed.data(), len));
+    }
+
+    WeightRegistry registry;
+    WeightBuffer a = registry.intern(WeightBuffer::copy(blob));
+    WeightBuffer b = registry.intern(WeightBuffer::copy(copy));
+    assert(a.data() == b.data() && b.use_count() == 2 && registry.sharedBytes() == bytes);
+    assert(registry.intern(WeightBuffer::copy(blob).converted(trt_types::DataType::kHALF)).data() != a.data() && "Dtype is part of the key.");
+    auto viewed = WeightBuffer::view(copy);
+    assert(registry.intern(viewed).data() == copy.data() && "Views are never interned.");
+    a = b = WeightBuffer();
+    assert(registry.size() == 0 && "Registry does not keep blobs alive.");
+    WeightBuffer c = registry.intern(WeightBuffer::copy(blob));
+    assert(c.use_count() == 1 && registry.size() == 1 && "Expired blobs are replaced, not resurrected.");
+
+    // Tied layers share buffers and constants, merged parameters included
+    Tied tied;
+    tied.intern(registry);
+    const auto& [s0, relu, s2] = tied.children();
+    assert(s0.weights().data() == s2.weights().data() && s0.biases().data() == s2.biases().data());
+    assert(std::get<0>(tied.lowered()).weights().data() == s0.weights().data());
+
+    DefaultLogger logger;
+    nvinfer1::IBuilder* builder = nvinfer1::createInferBuilder(logger);
+    trt_types::Network* network = builder->createNetworkV2(1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH));
+    auto input = network->addInput("input", trt_types::DataType::kFLOAT, trt_types::Dims3{1, 1, 4});
+    network->markOutput(*tied.addToNetwork(network, input));
+    int32_t constants = 0;
+    for (int32_t i = 0; i < network->getNbLayers(); ++i)
+        constants += network->getLayer(i)->getType() == nvinfer1::LayerType::kCONSTANT;
+    assert(constants == 2 && "One constant per unique blob.");
+    delete network;
+    delete builder;
+
+    // Equal blobs in separate buffers become one constant per network without global interning
+    Tied fresh;
+    assert(std::get<0>(fresh.children()).weights().data() != std::get<2>(fresh.children()).weights().data());
+    trttl::Network<Tied> deduped(logger, fresh);
+    constants = 0;
+    for (int32_t i = 0; i < deduped.definition()->getNbLayers(); ++i)
+        constants += deduped.definition()->getLayer(i)->getType() == nvinfer1::LayerType::kCONSTANT;
+    assert(constants == 2 && "Default policy deduplicates within the network.");
+
+    // Networks in one process share host memory when their policy interns weights
+    Model m1, m2;
+    assert(std::get<0>(m1.children()).weights().data() != std::get<0>(m2.children()).weights().data());
+    const std::size_t before = WeightRegistry::global().size();
+    trttl::Network<Model> plain(logger, m1);
+    assert(WeightRegistry::global().size() == before && "Global interning is opt-in.");
+    constexpr BuildPolicy interning{.name = "interning", .intern_weights = true};
+    trttl::Network<Model, interning> n1(logger, m1);
+    const std::size_t unique = WeightRegistry::global().size();
+    const std::size_t shared = WeightRegistry::global().sharedBytes();
+    trttl::Network<Model, interning> n2(logger, m2);
+    assert(WeightRegistry::global().size() == unique && WeightRegistry::global().sharedBytes() > shared);
+
+    std::cout << "Weight Dedup Test Passed!" << std::endl;
+}
+
+int main() {
+    try {
+        testSafetensorsLoad();
+        testNpyLoad();
+        testBindValidation();
+        testBindLayout();
+        testBoundNetwork();
+        testWeightDedup();
+
+        std::cout << "All Tests Passed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Test Failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#include "../include/trttl/binary_log.hpp"
+#include <iostream>
+#include <fstream>
+
+/*!
+* Usage: trttl_logdecode <trt.blog> [out.log] - `BinaryLog` file to text (stdout by default).
+*/
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <binary log> [text log]\n";
+        return 2;
+    }
+    try {
+        trttl::BinaryLogReader reader(argv[1]);
+        std::size_t n = 0;
+        if (argc > 2) {
+            std::ofstream out(argv[2]);
+            if (!out)
+                throw std::ios_base::failure(std::string("Failed to open output file: ") + argv[2]);
+            n = reader.decode(out);
+        } else {
+            n = reader.decode(std::cout);
+        }
+        std::cerr << n << " records, " << reader.siteCount() << " call sites\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Decode Failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}